@@ -37,7 +37,12 @@ namespace SPMod
             Stop = (1 << 0),
 
             /* Return the highest value returned by plugins */
-            Highest = (1 << 1)
+            Highest = (1 << 1),
+
+            /* Queue the call and execute it at the start of the next frame, returned result is ignored
+             * Forward cannot have params passed by reference nor arrays and it has to be global
+             * Meant for notifications which plugins do not need in order, no default forward is deferred */
+            Deferred = (1 << 2)
         };
 
         /*
@@ -74,14 +79,63 @@ namespace SPMod
                 String = (1 << 4)
             };
 
+            /*
+             * Param data
+             *
+             * @note Arrays are stored as pointer to their first element.
+             * @note Strings pushed by value are stored as const char *, buffers meant
+             *       to be copied back or with string flags are stored as char *.
+             */
+            using Data = std::variant<std::monostate, std::int32_t, float, std::int32_t *, float *, const char *, char *>;
+
             virtual ~IParam() = default;
-            virtual std::any getData() const = 0;
+            virtual Data getData() const = 0;
             virtual bool shouldCopyback() const = 0;
             virtual StringFlags getStringFlags() const = 0;
             virtual Type getDataType() const = 0;
             virtual std::size_t getDataSize() const = 0;
         };
 
+        /*
+         * Param passed to execFuncParams() when all params are supplied at once
+         *
+         * @note For strings passed by value data holds const char * and size holds length of the string,
+         *       it does not need to be null-terminated.
+         */
+        struct ExecParam
+        {
+            IParam::Type type;
+            IParam::Data data;
+            std::size_t size;
+            bool copyback;
+            StringFlags stringFlags;
+        };
+
+        /*
+         * Filter evaluated before a plugin gets the forward executed
+         */
+        struct Filter
+        {
+            enum class Type : std::uint8_t
+            {
+                /* String param equals to string */
+                String = 0,
+
+                /* Int param is within [min, max] */
+                IntRange,
+
+                /* Int param is a player index set in players bitmask, bit 0 is player 1 */
+                PlayerMask
+            };
+
+            Type type;
+            std::size_t param;
+            std::string string;
+            std::int32_t min;
+            std::int32_t max;
+            std::uint32_t players;
+        };
+
         /**
          * @brief Callback gets executed when forward is being executed.
          *
@@ -225,6 +279,39 @@ namespace SPMod
          */
         virtual bool execFunc(std::int32_t *result) = 0;
 
+        /*
+         * @brief Adds filter for plugin.
+         *
+         * @note Plugin gets the forward executed if any of its filters accepts pushed params.
+         *       Plugins without filters get all executions.
+         *
+         * @param plugin    Plugin to filter executions for.
+         * @param filter    Filter to add.
+         *
+         * @return          True if succeed, false if param does not exist or its type does not match filter.
+         */
+        virtual bool addFilter(const IPlugin *plugin, const Filter &filter) = 0;
+
+        /*
+         * @brief Removes all filters of plugin.
+         *
+         * @param plugin    Plugin to remove filters of.
+         *
+         * @noreturn
+         */
+        virtual void removeFilters(const IPlugin *plugin) = 0;
+
+        /*
+         * @brief Checks if forward being executed should be passed to plugin.
+         *
+         * @note Meant to be called by listeners before entering plugin.
+         *
+         * @param plugin    Plugin to check.
+         *
+         * @return          True if plugin has no filters or any of them accepts pushed params, false otherwise.
+         */
+        virtual bool passesFilters(const IPlugin *plugin) const = 0;
+
         /*
          * @brief Resets params already pushed to forward.
          *
@@ -234,15 +321,36 @@ namespace SPMod
 
     protected:
         virtual std::array<IParam *, MAX_EXEC_PARAMS> getParamsImpl() const = 0;
+
+    public:
+        /*
+         * @brief Sets all params and executes the forward.
+         *
+         * @note Params pushed before are discarded.
+         * @note Param result can be nullptr only if exec type of forward is ignore.
+         *
+         * @param result    Address where the result will be stored.
+         * @param params    Params to pass, their types must match the forward ones.
+         * @param num       Number of params.
+         *
+         * @return          True if succeed, false if params do not match or execution failed.
+         */
+        virtual bool execFuncParams(std::int32_t *result, const ExecParam *params, std::size_t num) = 0;
     };
 
     class IForwardMngr : public ISPModInterface
     {
     public:
-        static constexpr std::uint16_t MAJOR_VERSION = 0;
+        static constexpr std::uint16_t MAJOR_VERSION = 1;
         static constexpr std::uint16_t MINOR_VERSION = 0;
 
         static constexpr std::uint32_t VERSION = (MAJOR_VERSION << 16 | MINOR_VERSION);
+
+        /**
+         * @brief Value returned by getForwardHandle() for unknown forwards.
+         */
+        static constexpr std::size_t INVALID_HANDLE = std::numeric_limits<std::size_t>::max();
+
         /**
          * @brief Gets interface's name.
          *
@@ -334,6 +442,15 @@ namespace SPMod
          */
         virtual bool deleteForward(const IForward *forward) = 0;
 
+        /*
+         * @brief Finds multi forward.
+         *
+         * @param name      Name of the forward.
+         *
+         * @return          Forward pointer, nullptr if not found.
+         */
+        virtual IForward *getForward(std::string_view name) const = 0;
+
         /*
          * @brief Adds listener.
          *
@@ -342,5 +459,48 @@ namespace SPMod
          * @noreturn
          */
         virtual void addForwardListener(IForward::Callback func) = 0;
+
+        /*
+         * @brief Gets handle of the forward.
+         *
+         * @note Handle stays valid until the forward is deleted and is never reused by another forward
+         *       until all forwards are cleared on map change.
+         *
+         * @param forward   Forward to get handle of.
+         *
+         * @return          Forward handle, INVALID_HANDLE if forward is not managed by this manager.
+         */
+        virtual std::size_t getForwardHandle(const IForward *forward) const = 0;
+
+        /*
+         * @brief Gets forward by its handle.
+         *
+         * @note Lookup is done in constant time, use it instead of keeping names in hot paths.
+         *
+         * @param handle    Forward handle.
+         *
+         * @return          Forward pointer, nullptr if handle is invalid or forward has been deleted.
+         */
+        virtual IForward *getForwardByHandle(std::size_t handle) const = 0;
+
+        /*
+         * @brief Checks if forwards profiler is running.
+         *
+         * @note Listeners should only measure execution time if the profiler is running.
+         *
+         * @return          True if running, false otherwise.
+         */
+        virtual bool isProfiling() const = 0;
+
+        /*
+         * @brief Records execution time of forward in a plugin.
+         *
+         * @param forward       Executed forward.
+         * @param plugin        Plugin the forward has been executed in.
+         * @param nanoseconds   Execution time.
+         *
+         * @noreturn
+         */
+        virtual void addProfileSample(const IForward *forward, const IPlugin *plugin, std::uint64_t nanoseconds) = 0;
     };
 } // namespace SPMod
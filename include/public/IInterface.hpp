@@ -69,11 +69,19 @@ namespace SPMod
          *
          * @param reqversion    Version to be checked.
          *
+         * @note Major versions have to match, requested minor version cannot be newer.
+         *
          * @return              True if is compatible, false otherwise.
          */
         virtual bool isVersionCompatible(std::uint32_t reqversion) const
         {
-            return (reqversion > getVersion() ? false : true);
+            if (std::uint16_t majorReqVer = reqversion >> 16; majorReqVer != (getVersion() >> 16))
+                return false;
+
+            if (std::uint16_t minorReqVer = reqversion & 0xFFFF; minorReqVer > (getVersion() & 0xFFFF))
+                return false;
+
+            return true;
         }
 
         /**
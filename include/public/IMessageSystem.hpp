@@ -59,11 +59,29 @@ namespace SPMod
         SPEC = 9,           /**< Sends to all spectator proxies */
     };
 
+    constexpr std::size_t MAX_MSG_DESTS = 10U;
+
     namespace Engine
     {
         class IEdict;
     }
 
+    /**
+     *  Messages sent over the last second.
+     */
+    struct MsgStats
+    {
+        struct Counter
+        {
+            std::uint32_t messages;
+            std::uint32_t bytes;
+        };
+
+        std::array<Counter, MAX_USER_MESSAGES> types;  /**< Indexed by message type */
+        std::array<Counter, MAX_MSG_DESTS> dests;      /**< Indexed by MsgDest */
+        std::array<Counter, MAX_PLAYERS + 1> players;  /**< Indexed by player, PVS and PAS messages are not included */
+    };
+
     class IMessage
     {
     public:
@@ -89,6 +107,30 @@ namespace SPMod
         virtual Engine::IEdict *getEdict() const = 0;
     };
 
+    /**
+     *  Condition which has to be met for message hook to be executed.
+     */
+    struct MsgCondition
+    {
+        enum class Type : std::uint8_t
+        {
+            ParamEquals = 0, /**< Param equals to value (real for angle and coord params) */
+            ParamLess,       /**< Param is less than value (real for angle and coord params) */
+            ParamGreater,    /**< Param is greater than value (real for angle and coord params) */
+            ParamString,     /**< String param equals to string */
+            Dest,            /**< Message is sent to dest */
+            Players          /**< Message is sent to player in players bitmask, bit 0 is player 1 */
+        };
+
+        Type type;
+        std::size_t param;
+        int value;
+        float real;
+        std::string string;
+        MsgDest dest;
+        std::uint32_t players;
+    };
+
     class IMessageHook
     {
     public:
@@ -98,6 +140,94 @@ namespace SPMod
         virtual void disable() = 0;
         virtual bool isActive() const = 0;
         virtual int getMsgType() const = 0;
+
+        /**
+         * @brief Adds condition to the hook.
+         *
+         * @note Hook is executed only if all of its conditions are met. Messages which do not
+         *       meet conditions of any hook are not intercepted at all, as far as dest and
+         *       players conditions can tell.
+         *
+         * @param condition     Condition to add.
+         *
+         * @noreturn
+         */
+        virtual void addCondition(const MsgCondition &condition) = 0;
+
+        /**
+         * @brief Removes all conditions of the hook.
+         *
+         * @noreturn
+         */
+        virtual void clearConditions() = 0;
+    };
+
+    /**
+     *  Value of a template slot, integer and float values are converted to the slot type.
+     *  Strings are passed to the engine as they are, so they have to be null terminated.
+     */
+    using MsgSlotValue = std::variant<int, float, std::string_view>;
+
+    class IMessageTemplate
+    {
+    public:
+        static constexpr std::size_t INVALID_SLOT = static_cast<std::size_t>(-1);
+
+        virtual ~IMessageTemplate() = default;
+
+        /**
+         * @brief Returns message index of the template.
+         *
+         * @return              Message index.
+         */
+        virtual int getMsgType() const = 0;
+
+        /**
+         * @brief Appends param with fixed value.
+         *
+         * @param type          Param type.
+         * @param value         Param value.
+         *
+         * @noreturn
+         */
+        virtual void addParam(MsgParamType type, int value) = 0;
+        virtual void addParam(MsgParamType type, float value) = 0;
+        virtual void addParam(MsgParamType type, std::string_view value) = 0;
+
+        /**
+         * @brief Appends param which value is given when the template is sent.
+         *
+         * @param type          Param type.
+         * @param name          Name of the slot, must be unique within the template.
+         *
+         * @return              Slot index, INVALID_SLOT if the name is already taken.
+         */
+        virtual std::size_t addSlot(MsgParamType type, std::string_view name) = 0;
+
+        /**
+         * @brief Finds slot by its name.
+         *
+         * @param name          Name of the slot.
+         *
+         * @return              Slot index, INVALID_SLOT if not found.
+         */
+        virtual std::size_t getSlot(std::string_view name) const = 0;
+
+        /**
+         * @brief Returns number of slots.
+         *
+         * @return              Number of slots.
+         */
+        virtual std::size_t getSlots() const = 0;
+
+        /**
+         * @brief Returns type of the slot param.
+         *
+         * @param slot          Slot index.
+         *
+         * @return              Param type.
+         */
+        virtual MsgParamType getSlotType(std::size_t slot) const = 0;
     };
 
     class IMessageMngr : public ISPModInterface
@@ -106,7 +236,7 @@ namespace SPMod
         virtual ~IMessageMngr() = default;
 
         static constexpr std::uint16_t MAJOR_VERSION = 0;
-        static constexpr std::uint16_t MINOR_VERSION = 0;
+        static constexpr std::uint16_t MINOR_VERSION = 4;
 
         static constexpr std::uint32_t VERSION = (MAJOR_VERSION << 16 | MINOR_VERSION);
         /**
@@ -139,5 +269,85 @@ namespace SPMod
 
         virtual IMessage *getMessage() const = 0;
         virtual bool inHook() const = 0;
+
+        /**
+         * @brief Creates message template.
+         *
+         * @param msgType       Message index.
+         *
+         * @return              Template, nullptr if message index is invalid.
+         */
+        virtual IMessageTemplate *createTemplate(int msgType) = 0;
+
+        /**
+         * @brief Destroys message template.
+         *
+         * @param msgTemplate   Template to destroy.
+         *
+         * @noreturn
+         */
+        virtual void destroyTemplate(IMessageTemplate *msgTemplate) = 0;
+
+        /**
+         * @brief Sends message built from template.
+         *
+         * @param msgTemplate   Template to send.
+         * @param dest          Message destination.
+         * @param origin        Message origin, can be nullptr.
+         * @param target        Receiver for ONE dests, can be nullptr otherwise.
+         * @param values        Values of the slots in slot order.
+         * @param count         Number of values, must match number of slots.
+         * @param hookable      True to let message hooks see the message.
+         *
+         * @return              True if message has been sent, false if values do not match slots.
+         */
+        virtual bool sendTemplate(const IMessageTemplate *msgTemplate,
+                                  MsgDest dest,
+                                  const float *origin,
+                                  Engine::IEdict *target,
+                                  const MsgSlotValue *values,
+                                  std::size_t count,
+                                  bool hookable = false) = 0;
+
+        /**
+         * @brief Enables or disables counting of sent messages.
+         *
+         * @param enable        True to enable, false to disable.
+         *
+         * @noreturn
+         */
+        virtual void setStatsEnabled(bool enable) = 0;
+
+        /**
+         * @brief Checks if sent messages are counted.
+         *
+         * @return              True if enabled, false otherwise.
+         */
+        virtual bool isStatsEnabled() const = 0;
+
+        /**
+         * @brief Retrieves number of messages and bytes sent over the last second.
+         *
+         * @note Bytes are estimated from written params plus message header.
+         *
+         * @param stats         Where to store the stats.
+         *
+         * @noreturn
+         */
+        virtual void getStats(MsgStats &stats) const = 0;
+
+        /**
+         * @brief Registers read-only hook called after the message has been sent.
+         *
+         * @note Messages only observed are not superseded, original writes reach the engine
+         *       untouched while params are recorded for observers. Changes made to params
+         *       and value returned by handler are ignored.
+         *
+         * @param msgType       Message index.
+         * @param handler       Handler to call.
+         *
+         * @return              Hook, unregister it with unregisterHook().
+         */
+        virtual IMessageHook *registerObserver(int msgType, IMessage::Handler handler) = 0;
     };
 } // namespace SPMod
@@ -21,16 +21,20 @@
 
 #include <cinttypes>
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include <any>
 #include <string>
 #include <variant>
 #include <array>
+#include <bitset>
+#include <vector>
 #include <type_traits>
 #include <regex>
 #include <charconv>
 #include <optional>
 #include <unordered_map>
+#include <limits>
 
 #include <IHelpers.hpp>
 
@@ -75,6 +79,7 @@ namespace fs = std::experimental::filesystem;
 #include <metamod/IMetamod.hpp>
 
 #include <IForwardSystem.hpp>
+#include <TypedForward.hpp>
 #include <ICvarSystem.hpp>
 #include <ITimerSystem.hpp>
 #include <IMenuSystem.hpp>
@@ -21,6 +21,26 @@
 
 namespace SPMod
 {
+    class IPlugin;
+
+    /**
+     *  Delays between scheduled and actual executions of timers.
+     */
+    struct TimerLateness
+    {
+        static constexpr std::size_t BUCKETS_NUM = 8;
+
+        /**< Upper bounds of buckets in milliseconds, the last bucket has none */
+        static constexpr std::array<float, BUCKETS_NUM - 1> BUCKET_BOUNDS = {
+            {1.0f, 5.0f, 10.0f, 25.0f, 50.0f, 100.0f, 250.0f}};
+
+        std::array<std::uint64_t, BUCKETS_NUM> buckets;  /**< Executions by delay */
+        std::uint64_t execs;                             /**< Number of executions */
+        double totalDelay;                               /**< Sum of delays in seconds */
+        float worstDelay;                                /**< The biggest delay in seconds */
+        double callbacksTime;                            /**< Time spent in callbacks in seconds */
+    };
+
     class ITimer
     {
     public:
@@ -69,10 +89,9 @@ namespace SPMod
          * @brief Executes a timer.
          *
          * @note If callback returns false, timer will be removed.
+         * @note Timer removed by its own callback stays valid until the callback returns.
          *
-         * @param timer       Timer to be executed.
-         *
-         * @noreturn
+         * @return            False if callback returned false or removed the timer, true otherwise.
          */
         virtual bool exec() = 0;
     };
@@ -81,7 +100,7 @@ namespace SPMod
     {
     public:
         static constexpr uint16_t MAJOR_VERSION = 0;
-        static constexpr uint16_t MINOR_VERSION = 0;
+        static constexpr uint16_t MINOR_VERSION = 4;
 
         static constexpr uint32_t VERSION = (MAJOR_VERSION << 16 | MINOR_VERSION);
 
@@ -116,7 +135,7 @@ namespace SPMod
          * @param func        Callback function.
          * @param pause       True if timer should be paused after creation, false otherwise.
          *
-         * @return            Created timer.
+         * @return            Created timer, nullptr if interval is lesser than or equal to 0.
          */
         virtual ITimer *createTimer(float interval,
                                     ITimer::Callback func,
@@ -132,5 +151,132 @@ namespace SPMod
          * @noreturn
          */
         virtual void removeTimer(const ITimer *timer) = 0;
+
+        /**
+         * @brief Limits time spent on executing timers in a single frame.
+         *
+         * @note Due timers which do not fit in the budget are executed in the next frames, the earliest first.
+         *       At least one timer is executed every frame.
+         *
+         * @param budget      Time in milliseconds, 0 for no limit.
+         *
+         * @noreturn
+         */
+        virtual void setFrameBudget(float budget) = 0;
+
+        /**
+         * @brief Gets time limit of executing timers in a single frame.
+         *
+         * @return            Time in milliseconds, 0 if there is no limit.
+         */
+        virtual float getFrameBudget() const = 0;
+
+        /**
+         * @brief Gets how many times executions were postponed to the next frame due to the budget.
+         *
+         * @return            Number of postponed executions.
+         */
+        virtual std::uint64_t getDeferredExecs() const = 0;
+
+        /**
+         * @brief Gets the biggest delay between scheduled and actual execution of a timer.
+         *
+         * @return            Delay in seconds.
+         */
+        virtual float getWorstLateness() const = 0;
+
+        /**
+         * @brief Resets postponed executions counter and the biggest delay.
+         *
+         * @noreturn
+         */
+        virtual void resetBudgetStats() = 0;
+
+        /**
+         * @brief Gets delays of executions of timers created by the plugin.
+         *
+         * @note Delays are measured in server time, so they include frame time and the interval
+         *       timers are checked at.
+         *
+         * @param owner       Plugin which created timers, nullptr for timers without owner.
+         *
+         * @return            Delays, nullptr if no timer of the owner has been created.
+         */
+        virtual const TimerLateness *getLateness(const IPlugin *owner) const = 0;
+
+        /**
+         * @brief Resets delays of all owners.
+         *
+         * @noreturn
+         */
+        virtual void resetLateness() = 0;
+
+        /**
+         * @brief Gets timers of a group.
+         *
+         * @param owner       Plugin which created timers, nullptr for timers without owner.
+         * @param group       Group of timers.
+         *
+         * @return            Timers of the group.
+         */
+        virtual const std::vector<ITimer *> &getGroupTimers(const IPlugin *owner, std::uint32_t group) const = 0;
+
+        /**
+         * @brief Pauses all timers of a group.
+         *
+         * @param owner       Plugin which created timers, nullptr for timers without owner.
+         * @param group       Group of timers.
+         *
+         * @noreturn
+         */
+        virtual void pauseGroup(const IPlugin *owner, std::uint32_t group) = 0;
+
+        /**
+         * @brief Unpauses all paused timers of a group.
+         *
+         * @param owner       Plugin which created timers, nullptr for timers without owner.
+         * @param group       Group of timers.
+         *
+         * @noreturn
+         */
+        virtual void resumeGroup(const IPlugin *owner, std::uint32_t group) = 0;
+
+        /**
+         * @brief Removes all timers of a group.
+         *
+         * @param owner       Plugin which created timers, nullptr for timers without owner.
+         * @param group       Group of timers.
+         *
+         * @noreturn
+         */
+        virtual void cancelGroup(const IPlugin *owner, std::uint32_t group) = 0;
+
+        /**
+         * @brief Removes all timers of an owner, e.g. when the plugin is being unloaded.
+         *
+         * @param owner       Plugin which created timers, nullptr for timers without owner.
+         *
+         * @noreturn
+         */
+        virtual void cancelOwnerTimers(const IPlugin *owner) = 0;
+
+        /**
+         * @brief Creates a timer owned by a plugin.
+         *
+         * @note Delays of the timer are recorded for the owner, see getLateness().
+         *
+         * @param interval    Time interval.
+         * @param func        Callback function.
+         * @param pause       True if timer should be paused after creation, false otherwise.
+         * @param owner       Plugin which created the timer, nullptr if none.
+         * @param group       Group of the timer within timers of the owner.
+         *
+         * @return            Created timer, nullptr if interval is lesser than or equal to 0.
+         */
+        virtual ITimer *createOwnedTimer(float interval,
+                                         ITimer::Callback func,
+                                         bool pause,
+                                         IPlugin *owner,
+                                         std::uint32_t group = 0) = 0;
     };
 } // namespace SPMod
\ No newline at end of file
@@ -21,11 +21,13 @@
 
 namespace SPMod
 {
+    enum class TextMsgDest : std::uint8_t;
+
     class IUtils : public ISPModInterface
     {
     public:
         static constexpr uint16_t MAJOR_VERSION = 0;
-        static constexpr uint16_t MINOR_VERSION = 0;
+        static constexpr uint16_t MINOR_VERSION = 1;
 
         static constexpr uint32_t VERSION = (MAJOR_VERSION << 16 | MINOR_VERSION);
         /**
@@ -75,5 +77,67 @@ namespace SPMod
          * @return          Written chars to buffer.
          */
         virtual std::string strReplaced(std::string_view source, std::string_view from, std::string_view to) const = 0;
+
+        /**
+         * @brief Sends text message to multiple players.
+         *
+         * @note Message is truncated once and the same writes are replayed for every recipient.
+         *       Players who are not in game and bots are skipped.
+         *
+         * @param players   Recipients bitmask, bit 0 is player 1.
+         * @param msgDest   Where the message is shown.
+         * @param message   Message to send.
+         *
+         * @noreturn
+         */
+        virtual void sendTextMsg(std::uint32_t players, TextMsgDest msgDest, std::string_view message) const = 0;
+
+        /**
+         * @brief Sends text message to multiple players.
+         *
+         * @param players   Indexes of recipients.
+         * @param count     Number of recipients.
+         * @param msgDest   Where the message is shown.
+         * @param message   Message to send.
+         *
+         * @noreturn
+         */
+        virtual void sendTextMsg(const std::uint32_t *players,
+                                 std::size_t count,
+                                 TextMsgDest msgDest,
+                                 std::string_view message) const = 0;
+
+        /**
+         * @brief Shows menu to multiple players.
+         *
+         * @note Menu is split into chunks once and the same writes are replayed for every recipient.
+         *       Players who are not in game and bots are skipped.
+         *
+         * @param players   Recipients bitmask, bit 0 is player 1.
+         * @param slots     Keys bitmask.
+         * @param time      Time the menu is displayed for.
+         * @param menu      Menu text, truncated to 512 characters.
+         *
+         * @noreturn
+         */
+        virtual void showMenu(std::uint32_t players, std::uint32_t slots, std::uint32_t time, std::string_view menu)
+            const = 0;
+
+        /**
+         * @brief Shows menu to multiple players.
+         *
+         * @param players   Indexes of recipients.
+         * @param count     Number of recipients.
+         * @param slots     Keys bitmask.
+         * @param time      Time the menu is displayed for.
+         * @param menu      Menu text, truncated to 512 characters.
+         *
+         * @noreturn
+         */
+        virtual void showMenu(const std::uint32_t *players,
+                              std::size_t count,
+                              std::uint32_t slots,
+                              std::uint32_t time,
+                              std::string_view menu) const = 0;
     };
 } // namespace SPMod
@@ -51,6 +51,30 @@ namespace SPMod
         virtual void setReturn(Param retVal) = 0;
     };
 
+    /*
+     * @brief Entities whose calls of a hooked function are passed to callbacks.
+     *
+     * @note Entity passes if it matches any of the criteria, filter without criteria passes every entity.
+     */
+    struct VTableHookFilter
+    {
+        static constexpr std::size_t MAX_ENTITIES = 4096;
+
+        bool isEmpty() const
+        {
+            return !playersOnly && indexes.none() && classnames.empty();
+        }
+
+        /* Indexes of entities */
+        std::bitset<MAX_ENTITIES> indexes;
+
+        /* Entities with index in range of 1 to max clients */
+        bool playersOnly = false;
+
+        /* Classnames of entities, useful when several classes share the vtable */
+        std::vector<std::string> classnames;
+    };
+
     class IVTableHookManager : public ISPModInterface
     {
     public:
@@ -61,7 +85,7 @@ namespace SPMod
             TraceAttack
         };
 
-        static constexpr std::uint16_t MAJOR_VERSION = 0;
+        static constexpr std::uint16_t MAJOR_VERSION = 1;
         static constexpr std::uint16_t MINOR_VERSION = 0;
 
         static constexpr std::uint32_t VERSION = (MAJOR_VERSION << 16 | MINOR_VERSION);
@@ -90,7 +114,27 @@ namespace SPMod
 
         virtual ~IVTableHookManager() = default;
 
-        virtual IVTableHook *registerHook(vFuncType vFunc, std::string_view classname) = 0;
+        virtual IVTableHook *registerHook(vFuncType vFunc,
+                                          std::string_view classname,
+                                          const VTableHookFilter *filter = nullptr) = 0;
+
+        /**
+         * @brief Hooks virtual function of a class.
+         *
+         * @note Function has to have its offset and signature in gamedata offsets.yml,
+         *       e.g. think, touch, use, killed or blocked.
+         * @note Hook is shared by all registrations, so callbacks get calls of entities
+         *       passing filter of any of them. Calls of other entities only run the original function.
+         *
+         * @param function      Name of the function in gamedata.
+         * @param classname     Classname of the entity.
+         * @param filter        Entities to get calls of, nullptr for all entities.
+         *
+         * @return              Hook, nullptr if the function cannot be hooked.
+         */
+        virtual IVTableHook *registerHook(std::string_view function,
+                                          std::string_view classname,
+                                          const VTableHookFilter *filter = nullptr) = 0;
         virtual void addCallback(IVTableHook::Callback callback) = 0;
     };
 } // namespace SPMod
\ No newline at end of file
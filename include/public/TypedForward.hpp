@@ -0,0 +1,223 @@
+/*
+ *  Copyright (C) 2018-2020 SPMod Development Team
+ *
+ *  This file is part of SPMod.
+ *
+ *  SPMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  SPMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with SPMod.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace SPMod
+{
+    /*
+     * @brief Array param of typed forward.
+     */
+    template<typename T>
+    struct ForwardArray
+    {
+        T *data;
+        std::size_t size;
+        bool copyback;
+    };
+
+    /*
+     * @brief String buffer param of typed forward, can be copied back.
+     */
+    struct ForwardStringBuffer
+    {
+        char *buffer;
+        std::size_t size;
+        IForward::StringFlags flags;
+        bool copyback;
+    };
+
+    /*
+     * @brief Maps C++ type to forward param type.
+     *
+     * @note Pointers to int and float are always copied back.
+     */
+    template<typename T>
+    struct ForwardParamTraits
+    {
+        static_assert(!std::is_same_v<T, T>, "Unsupported forward param type");
+    };
+
+    template<>
+    struct ForwardParamTraits<std::int32_t>
+    {
+        static constexpr IForward::IParam::Type type = IForward::IParam::Type::Int;
+
+        static IForward::ExecParam make(std::int32_t value)
+        {
+            return {type, value, 0, false, IForward::StringFlags::None};
+        }
+    };
+
+    template<>
+    struct ForwardParamTraits<float>
+    {
+        static constexpr IForward::IParam::Type type = IForward::IParam::Type::Float;
+
+        static IForward::ExecParam make(float value)
+        {
+            return {type, value, 0, false, IForward::StringFlags::None};
+        }
+    };
+
+    template<>
+    struct ForwardParamTraits<std::int32_t *>
+    {
+        static constexpr IForward::IParam::Type type = IForward::IParam::Type::Int | IForward::IParam::Type::Pointer;
+
+        static IForward::ExecParam make(std::int32_t *value)
+        {
+            return {type, value, 0, true, IForward::StringFlags::None};
+        }
+    };
+
+    template<>
+    struct ForwardParamTraits<float *>
+    {
+        static constexpr IForward::IParam::Type type = IForward::IParam::Type::Float | IForward::IParam::Type::Pointer;
+
+        static IForward::ExecParam make(float *value)
+        {
+            return {type, value, 0, true, IForward::StringFlags::None};
+        }
+    };
+
+    template<>
+    struct ForwardParamTraits<ForwardArray<std::int32_t>>
+    {
+        static constexpr IForward::IParam::Type type = IForward::IParam::Type::Int | IForward::IParam::Type::Array;
+
+        static IForward::ExecParam make(const ForwardArray<std::int32_t> &value)
+        {
+            return {type, value.data, value.size, value.copyback, IForward::StringFlags::None};
+        }
+    };
+
+    template<>
+    struct ForwardParamTraits<ForwardArray<float>>
+    {
+        static constexpr IForward::IParam::Type type = IForward::IParam::Type::Float | IForward::IParam::Type::Array;
+
+        static IForward::ExecParam make(const ForwardArray<float> &value)
+        {
+            return {type, value.data, value.size, value.copyback, IForward::StringFlags::None};
+        }
+    };
+
+    template<>
+    struct ForwardParamTraits<std::string_view>
+    {
+        static constexpr IForward::IParam::Type type = IForward::IParam::Type::String;
+
+        static IForward::ExecParam make(std::string_view value)
+        {
+            return {type, value.data(), value.length(), false, IForward::StringFlags::None};
+        }
+    };
+
+    template<>
+    struct ForwardParamTraits<ForwardStringBuffer>
+    {
+        static constexpr IForward::IParam::Type type = IForward::IParam::Type::String;
+
+        static IForward::ExecParam make(const ForwardStringBuffer &value)
+        {
+            // Buffer which is not written to is passed the same way as string by value
+            if (!value.copyback && value.flags == IForward::StringFlags::None)
+                return {type, const_cast<const char *>(value.buffer), std::strlen(value.buffer), false, value.flags};
+
+            return {type, value.buffer, value.size, value.copyback, value.flags};
+        }
+    };
+
+    /*
+     * @brief Forward with param types known at compile time.
+     *
+     * @note All params are passed to the forward in a single call,
+     *       so there is no need to push them one by one.
+     *
+     * @tparam Args     Param types, see ForwardParamTraits for supported ones.
+     */
+    template<typename... Args>
+    class TypedForward
+    {
+        static_assert(sizeof...(Args) <= IForward::MAX_EXEC_PARAMS, "Too many forward params");
+
+    public:
+        static constexpr std::array<IForward::IParam::Type, IForward::MAX_EXEC_PARAMS> PARAMS_TYPES = {
+            {ForwardParamTraits<Args>::type...}};
+
+        TypedForward() = default;
+
+        /*
+         * @brief Creates forward.
+         *
+         * @param fwdMngr   Forward manager.
+         * @param name      Name of the forward.
+         * @param exec      Exec type.
+         * @param plugin    Plugin which the forward will be executed in, nullptr for all plugins.
+         */
+        TypedForward(IForwardMngr *fwdMngr,
+                     std::string_view name,
+                     IForward::ExecType exec = IForward::ExecType::Ignore,
+                     IPlugin *plugin = nullptr)
+            : m_forward(fwdMngr->createForward(name, exec, PARAMS_TYPES, plugin))
+        {
+        }
+
+        /*
+         * @brief Checks if forward has been created.
+         *
+         * @return          True if forward exists, false otherwise.
+         */
+        bool isValid() const
+        {
+            return m_forward != nullptr;
+        }
+
+        /*
+         * @brief Returns underlying forward.
+         *
+         * @return          Forward pointer, nullptr if creation failed.
+         */
+        IForward *getForward() const
+        {
+            return m_forward;
+        }
+
+        /*
+         * @brief Executes forward.
+         *
+         * @param result    Address where the result will be stored, can be nullptr only if exec type is ignore.
+         * @param args      Params to pass.
+         *
+         * @return          True if succeed, false if execution failed.
+         */
+        bool exec(std::int32_t *result, Args... args) const
+        {
+            const std::array<IForward::ExecParam, sizeof...(Args)> params = {
+                {ForwardParamTraits<Args>::make(args)...}};
+
+            return m_forward->execFuncParams(result, params.data(), params.size());
+        }
+
+    private:
+        IForward *m_forward = nullptr;
+    };
+} // namespace SPMod
@@ -130,52 +130,88 @@ std::size_t CommandMngr::getCommandsNum(ICommand::Type type)
 
 void CommandMngr::clearCommands()
 {
+    m_clientCmdsByName.clear();
+    m_clientRegexCmds.clear();
     m_clientCommands.clear();
     m_serverCommands.clear();
 }
 
+void CommandMngr::_indexClientCommand(Command *cmd)
+{
+    if (const auto *name = std::get_if<std::string>(&cmd->getNameOrRegex()); name)
+    {
+        // Commands are removed all at once, so the first one with the name outlives the key
+        m_clientCmdsByName[*name].emplace_back(cmd);
+    }
+    else
+    {
+        m_clientRegexCmds.emplace_back(cmd);
+    }
+}
+
+IForward::ReturnValue CommandMngr::_execClientCommand(Command *cmd, Player *player, META_RES &metaResult)
+{
+    if (!cmd->hasAccess(player))
+        return IForward::ReturnValue::Ignored;
+
+    IForward::ReturnValue result = cmd->execCallback(player);
+    if (result == IForward::ReturnValue::Stop || result == IForward::ReturnValue::Handled)
+        metaResult = MRES_SUPERCEDE;
+
+    return result;
+}
+
 META_RES CommandMngr::ClientCommandMeta(edict_t *entity, std::string_view clCmd)
+{
+    if (!getCommandsNum(ICommand::Type::Client))
+        return MRES_IGNORED;
+
+    if (clCmd != "say" && clCmd != "say_team")
+        return _matchClientCommand(entity, clCmd);
+
+    // Callback can issue another say command, buffer is in use until we return
+    std::string nestedCmdName;
+    std::string &cmdName = m_sayCmdNameUsed ? nestedCmdName : m_sayCmdName;
+    bool ownsBuffer = !m_sayCmdNameUsed;
+
+    cmdName.assign(clCmd);
+    cmdName += ' ';
+    cmdName += CMD_ARGV(1);
+
+    m_sayCmdNameUsed = true;
+    META_RES metaResult = _matchClientCommand(entity, cmdName);
+    if (ownsBuffer)
+        m_sayCmdNameUsed = false;
+
+    return metaResult;
+}
+
+META_RES CommandMngr::_matchClientCommand(edict_t *entity, std::string_view cmdName)
 {
     Player *player = gSPGlobal->getPlayerManager()->getPlayer(entity);
     META_RES metaResult = MRES_IGNORED;
-    if (getCommandsNum(ICommand::Type::Client))
+
+    if (auto iter = m_clientCmdsByName.find(cmdName); iter != m_clientCmdsByName.end())
     {
-        std::string cmdName(clCmd);
-        if (clCmd == "say" || clCmd == "say_team")
+        // Callback might register commands, indexes and references stay valid
+        const std::vector<Command *> &cmds = iter->second;
+        for (std::size_t i = 0; i < cmds.size(); i++)
         {
-            cmdName += ' ';
-            cmdName += CMD_ARGV(1);
+            if (_execClientCommand(cmds[i], player, metaResult) == IForward::ReturnValue::Stop)
+                return metaResult;
         }
+    }
 
-        for (const auto &cmd : getCommandList(ICommand::Type::Client))
-        {
-            bool commandMatched = std::visit(
-                [&cmdName](auto &&arg) {
-                    using T = std::decay_t<decltype(arg)>;
-                    if constexpr (std::is_same_v<T, std::string>)
-                    {
-                        return cmdName == arg;
-                    }
-                    else if constexpr (std::is_same_v<T, std::regex>)
-                    {
-                        return std::regex_search(cmdName, arg);
-                    }
-
-                    return false;
-                },
-                cmd->getNameOrRegex());
-            if (commandMatched && cmd->hasAccess(player))
-            {
-                IForward::ReturnValue result = cmd->execCallback(player);
-                if (result == IForward::ReturnValue::Stop || result == IForward::ReturnValue::Handled)
-                {
-                    metaResult = MRES_SUPERCEDE;
-                    if (result == IForward::ReturnValue::Stop)
-                        break;
-                }
-            }
-        }
+    for (std::size_t i = 0; i < m_clientRegexCmds.size(); i++)
+    {
+        Command *cmd = m_clientRegexCmds[i];
+        if (!std::regex_search(cmdName.begin(), cmdName.end(), std::get<std::regex>(cmd->getNameOrRegex())))
+            continue;
+
+        if (_execClientCommand(cmd, player, metaResult) == IForward::ReturnValue::Stop)
+            break;
     }
+
     return metaResult;
 }
 
@@ -192,6 +228,22 @@ void CommandMngr::PluginSrvCommand()
     }
 }
 
+// Messages are recorded to and replayed from the logs dir only
+static std::optional<fs::path> _getMsgRecordPath(std::string_view file)
+{
+    fs::path relPath(file);
+    if (relPath.empty() || relPath.has_root_name() || relPath.has_root_directory())
+        return std::nullopt;
+
+    for (const auto &part : relPath)
+    {
+        if (part == "..")
+            return std::nullopt;
+    }
+
+    return gSPGlobal->getPath(DirType::Logs) / relPath;
+}
+
 void CommandMngr::SPModInfoCommand()
 {
     static constexpr std::size_t nameWidth = 25;
@@ -208,6 +260,12 @@ void CommandMngr::SPModInfoCommand()
                                       version - displays currently version\n \
                                       plugins - displays currently loaded plugins\n \
                                       adapters - displays currently loaded adapters\n \
+                                      profile <start|stop|dump> - profiles forwards execution\n \
+                                      msgstats [on|off] - displays messages sent over the last second\n \
+                                      msgrecord <start <file>|stop> - records messages to file in logs dir\n \
+                                      msgreplay <file> - runs recorded messages through message hooks\n \
+                                      timerbudget [ms|reset] - limits time spent on timers in a frame\n \
+                                      timers [reset] - displays delays of timer executions by plugin\n \
                                       gpl - displays spmod license");
     }
     else
@@ -275,6 +333,136 @@ You should have received a copy of the GNU General Public License\n \
                                                  entry.second->getAuthor());
             }
         }
+        else if (arg == "profile")
+        {
+            ForwardProfiler &profiler = gSPGlobal->getForwardManager()->getProfiler();
+            std::string_view action(CMD_ARGC() > 2 ? CMD_ARGV(2) : "");
+
+            if (action == "start")
+            {
+                profiler.start();
+                logger->sendMsgToConsoleInternal("Forwards profiler started");
+            }
+            else if (action == "stop")
+            {
+                profiler.stop();
+                logger->sendMsgToConsoleInternal("Forwards profiler stopped");
+            }
+            else if (action == "dump")
+            {
+                profiler.dump(logger);
+            }
+            else
+            {
+                logger->sendMsgToConsoleInternal("Usage: spmod profile <start|stop|dump>");
+            }
+        }
+        else if (arg == "msgstats")
+        {
+            MessageMngr *msgMngr = gSPGlobal->getMessageManager();
+            std::string_view action(CMD_ARGC() > 2 ? CMD_ARGV(2) : "");
+
+            if (action == "on")
+            {
+                msgMngr->setStatsEnabled(true);
+                logger->sendMsgToConsoleInternal("Messages stats enabled");
+            }
+            else if (action == "off")
+            {
+                msgMngr->setStatsEnabled(false);
+                logger->sendMsgToConsoleInternal("Messages stats disabled");
+            }
+            else if (msgMngr->isStatsEnabled())
+            {
+                msgMngr->getStatsCounter().dump(logger);
+            }
+            else
+            {
+                logger->sendMsgToConsoleInternal("Messages stats are disabled, use spmod msgstats on");
+            }
+        }
+        else if (arg == "msgrecord")
+        {
+            MessageMngr *msgMngr = gSPGlobal->getMessageManager();
+            std::string_view action(CMD_ARGC() > 2 ? CMD_ARGV(2) : "");
+
+            if (action == "start" && CMD_ARGC() > 3)
+            {
+                std::optional<fs::path> path = _getMsgRecordPath(CMD_ARGV(3));
+
+                if (!path)
+                    logger->sendMsgToConsoleInternal("File has to be relative to logs dir");
+                else if (msgMngr->startRecording(*path))
+                    logger->sendMsgToConsoleInternal("Recording messages to ", path->string());
+                else
+                    logger->sendMsgToConsoleInternal("Cannot open ", path->string());
+            }
+            else if (action == "stop")
+            {
+                msgMngr->stopRecording();
+                logger->sendMsgToConsoleInternal("Messages recording stopped");
+            }
+            else
+            {
+                logger->sendMsgToConsoleInternal("Usage: spmod msgrecord <start <file>|stop>");
+            }
+        }
+        else if (arg == "msgreplay")
+        {
+            if (CMD_ARGC() < 3)
+            {
+                logger->sendMsgToConsoleInternal("Usage: spmod msgreplay <file>");
+                return;
+            }
+
+            std::optional<fs::path> path = _getMsgRecordPath(CMD_ARGV(2));
+            if (!path)
+            {
+                logger->sendMsgToConsoleInternal("File has to be relative to logs dir");
+                return;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            std::size_t count = gSPGlobal->getMessageManager()->replayMessages(*path);
+            auto elapsed = std::chrono::steady_clock::now() - start;
+
+            logger->sendMsgToConsoleInternal("Replayed ", count, " messages from ", path->string(), " in ",
+                                             std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(),
+                                             " us");
+        }
+        else if (arg == "timerbudget")
+        {
+            TimerMngr *timerMngr = gSPGlobal->getTimerManager();
+            std::string_view action(CMD_ARGC() > 2 ? CMD_ARGV(2) : "");
+
+            if (action == "reset")
+            {
+                timerMngr->resetBudgetStats();
+            }
+            else if (!action.empty())
+            {
+                timerMngr->setFrameBudget(std::strtof(action.data(), nullptr));
+            }
+
+            logger->sendMsgToConsoleInternal("Frame budget: ", timerMngr->getFrameBudget(), " ms");
+            logger->sendMsgToConsoleInternal("Deferred executions: ", timerMngr->getDeferredExecs());
+            logger->sendMsgToConsoleInternal("Worst lateness: ", timerMngr->getWorstLateness() * 1000.0f, " ms");
+        }
+        else if (arg == "timers")
+        {
+            TimerMngr *timerMngr = gSPGlobal->getTimerManager();
+            std::string_view action(CMD_ARGC() > 2 ? CMD_ARGV(2) : "");
+
+            if (action == "reset")
+            {
+                timerMngr->resetLateness();
+                logger->sendMsgToConsoleInternal("Timer delays reset");
+            }
+            else
+            {
+                timerMngr->dumpLateness(logger);
+            }
+        }
         else if (arg == "version")
         {
             logger->sendMsgToConsoleInternal(CNSL_LBLUE, "SPMod ", CNSL_RESET, CNSL_LGREEN, "v", gSPModVersion);
@@ -105,7 +105,9 @@ public:
     {
         if constexpr (std::is_same_v<ClientCommand, T>)
         {
-            return m_clientCommands.emplace_back(std::make_unique<T>(std::forward<Args>(args)...));
+            const auto &cmd = m_clientCommands.emplace_back(std::make_unique<T>(std::forward<Args>(args)...));
+            _indexClientCommand(cmd.get());
+            return cmd;
         }
         else
         {
@@ -127,6 +129,20 @@ public:
     static void SPModInfoCommand();
 
 private:
+    void _indexClientCommand(Command *cmd);
+    META_RES _matchClientCommand(edict_t *entity, std::string_view cmdName);
+    IForward::ReturnValue _execClientCommand(Command *cmd, Player *player, META_RES &metaResult);
+
     std::vector<std::unique_ptr<Command>> m_clientCommands;
     std::vector<std::unique_ptr<Command>> m_serverCommands;
+
+    /* Client commands by name in order of registration, keys view names of the commands */
+    std::unordered_map<std::string_view, std::vector<Command *>> m_clientCmdsByName;
+
+    /* Client commands matched by regex, checked after the ones matched by name */
+    std::vector<Command *> m_clientRegexCmds;
+
+    /* Name of say commands with the first argument, reused to avoid allocations */
+    std::string m_sayCmdName;
+    bool m_sayCmdNameUsed = false;
 };
@@ -19,9 +19,40 @@
 
 #include "spmod.hpp"
 
-Forward::Param::Param(Type type) : m_dataType(type), m_copyback(false), m_stringFlags(Forward::StringFlags::None) {}
+namespace
+{
+    // Checks if data holds alternative pushed for the type
+    bool dataMatchesType(Forward::Param::Type type, const Forward::Param::Data &data)
+    {
+        using Type = Forward::Param::Type;
+
+        if (type == Type::Int)
+            return std::holds_alternative<std::int32_t>(data);
+        if (type == (Type::Int | Type::Pointer))
+            return std::holds_alternative<std::int32_t *>(data);
+        if (type == Type::Float)
+            return std::holds_alternative<float>(data);
+        if (type == (Type::Float | Type::Pointer))
+            return std::holds_alternative<float *>(data);
+        if (type == Type::Array)
+            return std::holds_alternative<std::int32_t *>(data) || std::holds_alternative<float *>(data);
+        if (type == Type::String)
+            return std::holds_alternative<const char *>(data) || std::holds_alternative<char *>(data);
+
+        return false;
+    }
+}
 
-std::any Forward::Param::getData() const
+Forward::Param::Param(Type type)
+    : m_dataType(type), m_size(0), m_copyback(false), m_stringFlags(Forward::StringFlags::None)
+{
+    if (m_dataType == Type::String)
+    {
+        m_string.reserve(STRING_RESERVED_SIZE);
+    }
+}
+
+Forward::Param::Data Forward::Param::getData() const
 {
     return m_data;
 }
@@ -46,11 +77,17 @@ std::size_t Forward::Param::getDataSize() const
     return m_size;
 }
 
-void Forward::Param::setData(std::any data)
+void Forward::Param::setData(Data data)
 {
     m_data = data;
 }
 
+void Forward::Param::setString(std::string_view string)
+{
+    m_string.assign(string);
+    m_data = m_string.c_str();
+}
+
 void Forward::Param::setSize(std::size_t size)
 {
     m_size = size;
@@ -69,7 +106,7 @@ void Forward::Param::setStringFlags(Forward::StringFlags stringFlags)
 Forward::Forward(std::string_view name,
                  std::array<Forward::Param::Type, IForward::MAX_EXEC_PARAMS> paramstypes,
                  const std::vector<Forward::Callback> &callbacks)
-    : m_name(name), m_paramsNum(0), m_callbacks(callbacks), m_currentPos(0)
+    : m_name(name), m_paramsNum(0), m_callbacks(callbacks), m_currentPos(0), m_handle(IForwardMngr::INVALID_HANDLE)
 {
     std::size_t i = 0;
     for (auto type : paramstypes)
@@ -98,6 +135,16 @@ bool Forward::isExecuted() const
     return m_exec;
 }
 
+std::size_t Forward::getHandle() const
+{
+    return m_handle;
+}
+
+void Forward::setHandle(std::size_t handle)
+{
+    m_handle = handle;
+}
+
 bool Forward::pushInt(std::int32_t integer)
 {
     if (m_currentPos >= m_paramsNum)
@@ -200,7 +247,7 @@ bool Forward::pushArray(std::variant<std::int32_t *, float *> array, std::size_t
             return false;
 
         param->setSize(size);
-        param->setData(array);
+        param->setData(std::visit([](auto &&arg) -> Param::Data { return arg; }, array));
         param->setCopyback(copyback);
     }
     catch (const std::out_of_range &e [[maybe_unused]])
@@ -223,7 +270,9 @@ bool Forward::pushString(std::string_view string)
         if (param->getDataType() != Forward::Param::Type::String)
             return false;
 
-        param->setData(std::string(string));
+        param->setString(string);
+        param->setCopyback(false);
+        param->setStringFlags(IForward::StringFlags::None);
     }
     catch (const std::out_of_range &e [[maybe_unused]])
     {
@@ -245,7 +294,12 @@ bool Forward::pushString(char *buffer, std::size_t size, IForward::StringFlags s
         if (param->getDataType() != Forward::Param::Type::String)
             return false;
 
-        param->setData(buffer);
+        // Nothing to copy back, plugins can read the buffer as a regular string
+        if (copyback || sflags != IForward::StringFlags::None)
+            param->setData(buffer);
+        else
+            param->setData(const_cast<const char *>(buffer));
+
         param->setSize(size);
         param->setCopyback(copyback);
         param->setStringFlags(sflags);
@@ -284,6 +338,39 @@ bool MultiForward::execFunc(std::int32_t *result)
     if (m_paramsNum > m_currentPos)
         return false;
 
+    if (m_execType == ExecType::Deferred)
+    {
+        gSPGlobal->getForwardManager()->deferExec(this);
+
+        if (result)
+            *result = 0;
+
+        m_currentPos = 0;
+        return true;
+    }
+
+    _exec(result);
+    return true;
+}
+
+void MultiForward::execDeferred(const Param::Data *params)
+{
+    for (std::size_t i = 0; i < m_paramsNum; i++)
+        m_params[i]->setData(params[i]);
+
+    m_currentPos = m_paramsNum;
+    _exec(nullptr);
+}
+
+void MultiForward::_exec(std::int32_t *result)
+{
+    ForwardProfiler &profiler = gSPGlobal->getForwardManager()->getProfiler();
+    bool profiling = profiler.isRunning();
+    std::chrono::steady_clock::time_point start;
+
+    if (profiling)
+        start = std::chrono::steady_clock::now();
+
     m_exec = true;
 
     std::int32_t returnValue = 0;
@@ -302,7 +389,11 @@ bool MultiForward::execFunc(std::int32_t *result)
     m_exec = false;
     m_currentPos = 0;
 
-    return true;
+    if (profiling)
+    {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        profiler.addSample(this, nullptr, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
 }
 
 void Forward::resetParams()
@@ -310,6 +401,110 @@ void Forward::resetParams()
     m_currentPos = 0;
 }
 
+bool Forward::addFilter(const IPlugin *plugin, const Filter &filter)
+{
+    if (filter.param >= m_paramsNum)
+        return false;
+
+    Param::Type paramType = m_params[filter.param]->getDataType();
+    if (filter.type == Filter::Type::String)
+    {
+        if (paramType != Param::Type::String)
+            return false;
+    }
+    else if (paramType != Param::Type::Int)
+        return false;
+
+    m_filters[plugin].emplace_back(filter);
+    return true;
+}
+
+void Forward::removeFilters(const IPlugin *plugin)
+{
+    m_filters.erase(plugin);
+}
+
+bool Forward::passesFilters(const IPlugin *plugin) const
+{
+    if (m_filters.empty())
+        return true;
+
+    auto iter = m_filters.find(plugin);
+    if (iter == m_filters.end())
+        return true;
+
+    for (const auto &filter : iter->second)
+    {
+        Param::Data data = m_params[filter.param]->getData();
+
+        switch (filter.type)
+        {
+            case Filter::Type::String:
+            {
+                const char *string = nullptr;
+                if (auto *constString = std::get_if<const char *>(&data))
+                    string = *constString;
+                else if (auto *buffer = std::get_if<char *>(&data))
+                    string = *buffer;
+
+                if (string && filter.string == string)
+                    return true;
+
+                break;
+            }
+            case Filter::Type::IntRange:
+            {
+                const auto *value = std::get_if<std::int32_t>(&data);
+                if (value && *value >= filter.min && *value <= filter.max)
+                    return true;
+
+                break;
+            }
+            case Filter::Type::PlayerMask:
+            {
+                const auto *value = std::get_if<std::int32_t>(&data);
+                if (value && *value >= 1 && *value <= static_cast<std::int32_t>(MAX_PLAYERS) &&
+                    filter.players & (1U << (*value - 1)))
+                    return true;
+
+                break;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool Forward::execFuncParams(std::int32_t *result, const ExecParam *params, std::size_t num)
+{
+    if (num != m_paramsNum)
+        return false;
+
+    for (std::size_t i = 0; i < num; i++)
+    {
+        const ExecParam &execParam = params[i];
+        Param *param = m_params[i].get();
+
+        if (param->getDataType() != execParam.type || !dataMatchesType(execParam.type, execParam.data))
+        {
+            m_currentPos = 0;
+            return false;
+        }
+
+        if (execParam.type == Param::Type::String && std::holds_alternative<const char *>(execParam.data))
+            param->setString({std::get<const char *>(execParam.data), execParam.size});
+        else
+            param->setData(execParam.data);
+
+        param->setSize(execParam.size);
+        param->setCopyback(execParam.copyback);
+        param->setStringFlags(execParam.stringFlags);
+    }
+
+    m_currentPos = num;
+    return execFunc(result);
+}
+
 MultiForward::MultiForward(std::string_view name,
                            std::array<Forward::Param::Type, MAX_EXEC_PARAMS> paramstypes,
                            ExecType type,
@@ -352,6 +547,13 @@ bool SingleForward::execFunc(std::int32_t *result)
     if (m_paramsNum > m_currentPos)
         return false;
 
+    ForwardProfiler &profiler = gSPGlobal->getForwardManager()->getProfiler();
+    bool profiling = profiler.isRunning();
+    std::chrono::steady_clock::time_point start;
+
+    if (profiling)
+        start = std::chrono::steady_clock::now();
+
     m_exec = true;
 
     // TODO: Execute the right callback except all of them
@@ -368,6 +570,12 @@ bool SingleForward::execFunc(std::int32_t *result)
     m_exec = false;
     m_currentPos = 0;
 
+    if (profiling)
+    {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        profiler.addSample(this, nullptr, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
     return true;
 }
 
@@ -375,28 +583,40 @@ void ForwardMngr::addDefaultsForwards()
 {
     using et = Forward::ExecType;
     using param = Forward::Param::Type;
+    using df = DefaultForward;
     std::array<Forward::Param::Type, Forward::MAX_EXEC_PARAMS> paramsList;
 
+    // None of these is deferred: client forwards have to keep their order relative to each other
+    // and the rest either return result or have to run before the caller continues
+    auto addDefault = [this](df which, const char *name, et exec,
+                             const std::array<Forward::Param::Type, Forward::MAX_EXEC_PARAMS> &params) {
+        m_defaultForwards.at(static_cast<std::size_t>(which)) = createForward(name, exec, params);
+    };
+
     paramsList = {{param::Int, param::String, param::String, param::String}};
-    createForward("OnClientConnect", et::Stop, paramsList);
-    createForward("OnClientConnectPost", et::Stop, paramsList);
+    addDefault(df::PlayerConnect, FWD_PLAYER_CONNECT, et::Stop, paramsList);
+    paramsList = {{param::Int, param::String, param::String}};
+    addDefault(df::PlayerConnected, FWD_PLAYER_CONNECTED, et::Stop, paramsList);
 
     paramsList = {{param::Int, param::Int, param::String}};
-    createForward("OnClientDisconnect", et::Ignore, paramsList);
-    createForward("OnClientDisconnectPost", et::Ignore, paramsList);
+    addDefault(df::PlayerDisconnect, FWD_PLAYER_DISCONNECT, et::Ignore, paramsList);
+    addDefault(df::PlayerDisconnected, FWD_PLAYER_DISCONNECTED, et::Ignore, paramsList);
 
     paramsList = {{param::Int}};
-    createForward("OnClientPutInServer", et::Ignore, paramsList);
-    createForward("OnClientPutInServerPost", et::Ignore, paramsList);
-    createForward("OnClientCommand", et::Stop, paramsList);
+    addDefault(df::PlayerEnter, FWD_PLAYER_ENTER, et::Ignore, paramsList);
+    addDefault(df::PlayerEntered, FWD_PLAYER_ENTERED, et::Ignore, paramsList);
+
+    paramsList = {{param::Int, param::String}};
+    addDefault(df::PlayerCommand, FWD_PLAYER_COMMAND, et::Stop, paramsList);
 
     paramsList = {{param::String}};
-    createForward("OnMapChange", et::Stop, paramsList);
+    addDefault(df::MapChange, FWD_MAP_CHANGE, et::Stop, paramsList);
 
-    createForward("OnPluginsLoaded");
-    createForward("OnPluginInit");
-    createForward("OnPluginEnd");
-    createForward("OnPluginNatives");
+    paramsList = {};
+    addDefault(df::PluginsLoaded, FWD_PLUGINS_LOADED, et::Ignore, paramsList);
+    addDefault(df::PluginInit, FWD_PLUGIN_INIT, et::Ignore, paramsList);
+    addDefault(df::PluginEnd, FWD_PLUGIN_END, et::Ignore, paramsList);
+    addDefault(df::PluginNatives, FWD_PLUGIN_NATIVES, et::Ignore, paramsList);
 }
 
 Forward *ForwardMngr::createForward(std::string_view name,
@@ -406,14 +626,27 @@ Forward *ForwardMngr::createForward(std::string_view name,
 {
     if (!plugin) // Global forward
     {
+        // Deferred forwards are executed after the caller returns, references would dangle by then
+        if (exec == Forward::ExecType::Deferred)
+        {
+            for (auto type : params)
+            {
+                if (type & Forward::Param::Type::Pointer || type & Forward::Param::Type::Array)
+                    return nullptr;
+            }
+        }
+
         // Global forward with the same name already found
         if (size_t count = m_forwards.count(name.data()); count)
             return nullptr;
 
-        return m_forwards.emplace(name.data(), std::make_unique<MultiForward>(name, params, exec, m_callbacks))
-            ->second.get();
+        return _addForward(std::make_unique<MultiForward>(name, params, exec, m_callbacks));
     }
 
+    // Single forwards are always executed right away
+    if (exec == Forward::ExecType::Deferred)
+        return nullptr;
+
     // Check if forward with the same name and for the same plugin is already registered
     for (auto iter = m_forwards.find(name.data()); iter != m_forwards.end(); iter++)
     {
@@ -421,8 +654,18 @@ Forward *ForwardMngr::createForward(std::string_view name,
             return nullptr;
     }
 
-    return m_forwards.emplace(name.data(), std::make_unique<SingleForward>(name, params, plugin, m_callbacks))
-        ->second.get();
+    return _addForward(std::make_unique<SingleForward>(name, params, plugin, m_callbacks));
+}
+
+Forward *ForwardMngr::_addForward(std::unique_ptr<Forward> forward)
+{
+    Forward *fwdPtr = forward.get();
+
+    fwdPtr->setHandle(m_handles.size());
+    m_handles.emplace_back(fwdPtr);
+    m_forwards.emplace(fwdPtr->getName(), std::move(forward));
+
+    return fwdPtr;
 }
 
 void ForwardMngr::addForwardListener(Forward::Callback func)
@@ -434,6 +677,74 @@ void ForwardMngr::clearForwards()
 {
     m_forwards.clear();
     m_callbacks.clear();
+    m_handles.clear();
+    m_defaultForwards.fill(nullptr);
+    m_deferred.clear();
+    m_deferredExecuting.clear();
+    m_profiler.clearIndex();
+}
+
+void ForwardMngr::DeferredQueue::clear()
+{
+    calls.clear();
+    params.clear();
+    strings.clear();
+    stringOffsets.clear();
+}
+
+void ForwardMngr::deferExec(MultiForward *forward)
+{
+    m_deferred.calls.push_back({forward, m_deferred.params.size()});
+
+    for (const auto &param : forward->getParams())
+    {
+        if (param->getDataType() == Forward::Param::Type::None)
+            break;
+
+        Forward::Param::Data data = param->getData();
+
+        if (param->getDataType() == Forward::Param::Type::String)
+        {
+            const char *string = std::visit(
+                [](auto &&arg) -> const char * {
+                    using T = std::decay_t<decltype(arg)>;
+                    if constexpr (std::is_same_v<T, const char *> || std::is_same_v<T, char *>)
+                        return arg;
+                    else
+                        return "";
+                },
+                data);
+
+            m_deferred.stringOffsets.emplace_back(m_deferred.params.size(), m_deferred.strings.size());
+            m_deferred.strings.append(string).push_back('\0');
+            data = std::monostate();
+        }
+
+        m_deferred.params.emplace_back(data);
+    }
+}
+
+void ForwardMngr::execDeferred()
+{
+    if (m_deferred.calls.empty())
+        return;
+
+    // Calls queued by plugins while executing go to the next frame
+    std::swap(m_deferred, m_deferredExecuting);
+
+    for (const auto &[paramIndex, offset] : m_deferredExecuting.stringOffsets)
+        m_deferredExecuting.params[paramIndex] = m_deferredExecuting.strings.c_str() + offset;
+
+    for (const auto &call : m_deferredExecuting.calls)
+    {
+        // Forward has been deleted in the meantime
+        if (!call.forward)
+            continue;
+
+        call.forward->execDeferred(m_deferredExecuting.params.data() + call.firstParam);
+    }
+
+    m_deferredExecuting.clear();
 }
 
 Forward *ForwardMngr::getForward(std::string_view name) const
@@ -446,6 +757,29 @@ Forward *ForwardMngr::getForward(std::string_view name) const
     return nullptr;
 }
 
+Forward *ForwardMngr::getForward(DefaultForward forward) const
+{
+    return m_defaultForwards[static_cast<std::size_t>(forward)];
+}
+
+std::size_t ForwardMngr::getForwardHandle(const IForward *forward) const
+{
+    std::size_t handle = static_cast<const Forward *>(forward)->getHandle();
+
+    if (handle >= m_handles.size() || m_handles[handle] != forward)
+        return INVALID_HANDLE;
+
+    return handle;
+}
+
+Forward *ForwardMngr::getForwardByHandle(std::size_t handle) const
+{
+    if (handle >= m_handles.size())
+        return nullptr;
+
+    return m_handles[handle];
+}
+
 bool ForwardMngr::deleteForward(const IForward *forward)
 {
     const IPlugin *plugin = forward->getPlugin();
@@ -459,13 +793,21 @@ bool ForwardMngr::deleteForward(const IForward *forward)
             continue;
         }
 
-        if (!plugin)
-        {
-            m_forwards.erase(iter);
-            return true;
-        }
-        else if (plugin == iter->second->getPlugin())
+        if (!plugin || plugin == iter->second->getPlugin())
         {
+            m_handles[iter->second->getHandle()] = nullptr;
+
+            for (auto *queue : {&m_deferred, &m_deferredExecuting})
+            {
+                for (auto &call : queue->calls)
+                {
+                    if (call.forward == iter->second.get())
+                        call.forward = nullptr;
+                }
+            }
+
+            std::replace(m_defaultForwards.begin(), m_defaultForwards.end(), iter->second.get(),
+                         static_cast<Forward *>(nullptr));
             m_forwards.erase(iter);
             return true;
         }
@@ -474,3 +816,131 @@ bool ForwardMngr::deleteForward(const IForward *forward)
 
     return false;
 }
+
+bool ForwardMngr::isProfiling() const
+{
+    return m_profiler.isRunning();
+}
+
+void ForwardMngr::addProfileSample(const IForward *forward, const IPlugin *plugin, std::uint64_t nanoseconds)
+{
+    m_profiler.addSample(static_cast<const Forward *>(forward), plugin, nanoseconds);
+}
+
+ForwardProfiler &ForwardMngr::getProfiler()
+{
+    return m_profiler;
+}
+
+std::uint64_t ForwardProfiler::Stats::getPercentile(double percentile) const
+{
+    auto rank = static_cast<std::uint64_t>(percentile * count);
+    std::uint64_t seen = 0;
+
+    for (std::size_t bucket = 0; bucket < BUCKETS_NUM; bucket++)
+    {
+        seen += histogram[bucket];
+
+        if (seen > rank)
+            return std::min(_getBucketValue(bucket), max);
+    }
+
+    return max;
+}
+
+void ForwardProfiler::start()
+{
+    m_stats.clear();
+    m_index.clear();
+    m_running = true;
+}
+
+void ForwardProfiler::stop()
+{
+    m_running = false;
+}
+
+bool ForwardProfiler::isRunning() const
+{
+    return m_running;
+}
+
+void ForwardProfiler::addSample(const Forward *forward, const IPlugin *plugin, std::uint64_t nanoseconds)
+{
+    if (!m_running)
+        return;
+
+    auto [iter, inserted] = m_index.try_emplace({forward->getHandle(), plugin}, nullptr);
+    if (inserted)
+    {
+        std::pair<std::string, std::string> key(forward->getName(), plugin ? plugin->getName() : "*");
+        iter->second = &m_stats[key];
+    }
+
+    Stats *stats = iter->second;
+    stats->count++;
+    stats->total += nanoseconds;
+    stats->max = std::max(stats->max, nanoseconds);
+    stats->histogram[_getBucket(nanoseconds)]++;
+}
+
+void ForwardProfiler::dump(const Logger *logger) const
+{
+    static constexpr std::size_t fwdWidth = 25;
+    static constexpr std::size_t plWidth = 20;
+    static constexpr std::size_t numWidth = 12;
+
+    std::vector<std::pair<const std::pair<std::string, std::string> *, const Stats *>> sorted;
+    for (const auto &[key, stats] : m_stats)
+        sorted.emplace_back(&key, &stats);
+
+    std::sort(sorted.begin(), sorted.end(),
+              [](const auto &lhs, const auto &rhs) { return lhs.second->total > rhs.second->total; });
+
+    logger->sendMsgToConsoleInternal("\nForwards profile", m_running ? " (running)" : "", ", times in microseconds");
+    logger->sendMsgToConsoleInternal(std::left, std::setw(fwdWidth), "forward", std::setw(plWidth), "plugin",
+                                     std::right, std::setw(numWidth), "calls", std::setw(numWidth), "total",
+                                     std::setw(numWidth), "p50", std::setw(numWidth), "p99", std::setw(numWidth),
+                                     "max");
+
+    for (const auto &[key, stats] : sorted)
+    {
+        logger->sendMsgToConsoleInternal(std::left, std::setw(fwdWidth), key->first.substr(0, fwdWidth - 1),
+                                         std::setw(plWidth), key->second.substr(0, plWidth - 1), std::right,
+                                         std::setw(numWidth), stats->count, std::setw(numWidth),
+                                         stats->total / 1000, std::setw(numWidth),
+                                         stats->getPercentile(0.50) / 1000, std::setw(numWidth),
+                                         stats->getPercentile(0.99) / 1000, std::setw(numWidth), stats->max / 1000);
+    }
+}
+
+void ForwardProfiler::clearIndex()
+{
+    m_index.clear();
+}
+
+std::size_t ForwardProfiler::_getBucket(std::uint64_t value)
+{
+    if (value < SUB_BUCKETS)
+        return static_cast<std::size_t>(value);
+
+    std::size_t octave = 0;
+    while (value >> (octave + 1))
+        octave++;
+
+    // Two bits below the most significant one select sub bucket
+    std::size_t subBucket = static_cast<std::size_t>(value >> (octave - 2)) & (SUB_BUCKETS - 1);
+    return (octave - 1) * SUB_BUCKETS + subBucket;
+}
+
+std::uint64_t ForwardProfiler::_getBucketValue(std::size_t bucket)
+{
+    if (bucket < SUB_BUCKETS)
+        return bucket;
+
+    std::size_t octave = bucket / SUB_BUCKETS + 1;
+    std::uint64_t subBucket = bucket % SUB_BUCKETS;
+
+    // Upper bound of the bucket
+    return ((SUB_BUCKETS + subBucket + 1) << (octave - 2)) - 1;
+}
@@ -32,6 +32,9 @@ public:
     class Param : public IParam
     {
     public:
+        /* Storage reserved upfront for string params, so pushing them does not allocate */
+        static constexpr std::size_t STRING_RESERVED_SIZE = 256;
+
         Param(Type type);
         Param() = delete;
         Param(const Param &other) = delete;
@@ -39,24 +42,26 @@ public:
         ~Param() = default;
 
         // IParam
-        std::any getData() const override;
+        Data getData() const override;
         bool shouldCopyback() const override;
         IForward::StringFlags getStringFlags() const override;
         Type getDataType() const override;
         std::size_t getDataSize() const override;
 
         // Param
-        void setData(std::any data);
+        void setData(Data data);
+        void setString(std::string_view string);
         void setSize(std::size_t size);
         void setCopyback(bool copyback);
         void setStringFlags(IForward::StringFlags stringFlags);
 
     private:
         Type m_dataType;
-        std::any m_data;
+        Data m_data;
         std::size_t m_size;
         bool m_copyback;                     /* True if data is meant to be overwritten */
         IForward::StringFlags m_stringFlags; /* String flags */
+        std::string m_string;                /* Copy of string pushed by value, keeps its capacity between calls */
     };
 
 public:
@@ -85,8 +90,17 @@ public:
 
     void resetParams() override;
 
+    bool addFilter(const IPlugin *plugin, const Filter &filter) override;
+    void removeFilters(const IPlugin *plugin) override;
+    bool passesFilters(const IPlugin *plugin) const override;
+
+    bool execFuncParams(std::int32_t *result, const ExecParam *params, std::size_t num) override;
+
     bool isExecuted() const;
 
+    std::size_t getHandle() const;
+    void setHandle(std::size_t handle);
+
 protected:
     std::array<IParam *, MAX_EXEC_PARAMS> getParamsImpl() const override;
 
@@ -108,6 +122,12 @@ protected:
 
     /* number of already pushed params */
     std::size_t m_currentPos;
+
+    /* index in forward manager handle table */
+    std::size_t m_handle;
+
+    /* plugins' filters, plugins not present here get all executions */
+    std::unordered_map<const IPlugin *, std::vector<Filter>> m_filters;
 };
 
 /*
@@ -136,7 +156,12 @@ public:
 
     bool execFunc(std::int32_t *result) override;
 
+    // MultiForward
+    void execDeferred(const Param::Data *params);
+
 private:
+    void _exec(std::int32_t *result);
+
     /* exec type of forward */
     ExecType m_execType;
 };
@@ -165,6 +190,7 @@ public:
     // IForward
     IPlugin *getPlugin() const override;
     ExecType getExecType() const override;
+
     bool execFunc(std::int32_t *result) override;
 
 private:
@@ -172,6 +198,64 @@ private:
     IPlugin *m_plugin;
 };
 
+/*
+ * @brief Collects execution times of forwards per plugin.
+ *        Samples are put into a log-linear histogram (4 buckets per power of two),
+ *        so percentiles are approximate within 25%.
+ */
+class ForwardProfiler
+{
+public:
+    static constexpr std::size_t SUB_BUCKETS = 4;
+    static constexpr std::size_t BUCKETS_NUM = 64 * SUB_BUCKETS;
+
+    struct Stats
+    {
+        std::uint64_t count = 0;
+        std::uint64_t total = 0;
+        std::uint64_t max = 0;
+        std::array<std::uint32_t, BUCKETS_NUM> histogram = {};
+
+        std::uint64_t getPercentile(double percentile) const;
+    };
+
+    ForwardProfiler() = default;
+    ForwardProfiler(const ForwardProfiler &other) = delete;
+    ForwardProfiler(ForwardProfiler &&other) = delete;
+    ~ForwardProfiler() = default;
+
+    void start();
+    void stop();
+    bool isRunning() const;
+
+    /* plugin is nullptr for the whole forward execution */
+    void addSample(const Forward *forward, const IPlugin *plugin, std::uint64_t nanoseconds);
+    void dump(const Logger *logger) const;
+
+    /* Forwards and plugins are gone, only stats are kept */
+    void clearIndex();
+
+private:
+    struct IndexHash
+    {
+        std::size_t operator()(const std::pair<std::size_t, const IPlugin *> &key) const
+        {
+            return std::hash<std::size_t>()(key.first) ^ (std::hash<const IPlugin *>()(key.second) << 1);
+        }
+    };
+
+    static std::size_t _getBucket(std::uint64_t value);
+    static std::uint64_t _getBucketValue(std::size_t bucket);
+
+    bool m_running = false;
+
+    /* Keyed by forward and plugin name, so stats survive map change */
+    std::map<std::pair<std::string, std::string>, Stats> m_stats;
+
+    /* Fast lookup by forward handle and plugin */
+    std::unordered_map<std::pair<std::size_t, const IPlugin *>, Stats *, IndexHash> m_index;
+};
+
 class ForwardMngr final : public IForwardMngr
 {
 public:
@@ -188,6 +272,25 @@ public:
     static constexpr const char *FWD_PLUGIN_END = "OnPluginEnd";
     static constexpr const char *FWD_PLUGIN_NATIVES = "OnPluginNatives";
 
+    /* Built-in forwards, resolved once in addDefaultsForwards() */
+    enum class DefaultForward : std::uint8_t
+    {
+        PlayerConnect = 0,
+        PlayerConnected,
+        PlayerDisconnect,
+        PlayerDisconnected,
+        PlayerEnter,
+        PlayerEntered,
+        PlayerCommand,
+        MapChange,
+        PluginsLoaded,
+        PluginInit,
+        PluginEnd,
+        PluginNatives,
+
+        Count
+    };
+
     ForwardMngr() = default;
     ForwardMngr(const ForwardMngr &other) = delete;
     ForwardMngr(ForwardMngr &&other) = delete;
@@ -202,14 +305,57 @@ public:
                            IPlugin *plugin = nullptr) override;
     void addForwardListener(Forward::Callback func) override;
     bool deleteForward(const IForward *forward) override;
+    std::size_t getForwardHandle(const IForward *forward) const override;
+    Forward *getForwardByHandle(std::size_t handle) const override;
+    bool isProfiling() const override;
+    void addProfileSample(const IForward *forward, const IPlugin *plugin, std::uint64_t nanoseconds) override;
+
+    Forward *getForward(std::string_view name) const override;
 
     // ForwardMngr
     void clearForwards();
-    Forward *getForward(std::string_view name) const;
+    Forward *getForward(DefaultForward forward) const;
 
     void addDefaultsForwards();
 
+    void deferExec(MultiForward *forward);
+    void execDeferred();
+
+    ForwardProfiler &getProfiler();
+
 private:
+    /* Calls of deferred forwards queued during a frame */
+    struct DeferredQueue
+    {
+        struct Call
+        {
+            MultiForward *forward;
+            std::size_t firstParam;
+        };
+
+        std::vector<Call> calls;
+        std::vector<Forward::Param::Data> params;
+
+        /* Strings are copied here, pointers are resolved once the queue stops growing */
+        std::string strings;
+        std::vector<std::pair<std::size_t, std::size_t>> stringOffsets; /* param index, offset in strings */
+
+        void clear();
+    };
+
+    Forward *_addForward(std::unique_ptr<Forward> forward);
+
     std::unordered_multimap<std::string, std::unique_ptr<Forward>> m_forwards;
     std::vector<Forward::Callback> m_callbacks;
+
+    /* Forwards indexed by their handles, slots of deleted forwards are not reused until clearForwards() */
+    std::vector<Forward *> m_handles;
+
+    std::array<Forward *, static_cast<std::size_t>(DefaultForward::Count)> m_defaultForwards = {};
+
+    /* Pending calls and calls being executed, swapped every frame so both keep their capacity */
+    DeferredQueue m_deferred;
+    DeferredQueue m_deferredExecuting;
+
+    ForwardProfiler m_profiler;
 };
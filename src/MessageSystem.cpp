@@ -30,47 +30,96 @@ namespace
     {
         return static_cast<MsgDest>(destType);
     }
+
+    void writeParam(const Engine::Funcs *funcs, MsgParamType type, int integer, float real, std::string_view string)
+    {
+        switch (type)
+        {
+            case MsgParamType::Byte:
+                funcs->writeByte(integer);
+                break;
+            case MsgParamType::Char:
+                funcs->writeChar(integer);
+                break;
+            case MsgParamType::Short:
+                funcs->writeShort(integer);
+                break;
+            case MsgParamType::Long:
+                funcs->writeLong(integer);
+                break;
+            case MsgParamType::Angle:
+                funcs->writeAngle(real);
+                break;
+            case MsgParamType::Coord:
+                funcs->writeCoord(real);
+                break;
+            case MsgParamType::String:
+                funcs->writeString(string);
+                break;
+            case MsgParamType::Entity:
+                funcs->writeEntity(integer);
+                break;
+        }
+    }
+
+    inline bool isFloatParam(MsgParamType type)
+    {
+        return type == MsgParamType::Angle || type == MsgParamType::Coord;
+    }
+}
+
+Message::Message()
+{
+    m_params.reserve(MAX_PARAMS);
+    m_strings.reserve(STRINGS_RESERVED_SIZE);
 }
 
 void Message::init(MsgDest dest, int type, const float *origin, Engine::Edict *edict)
 {
     m_dest = dest;
     m_type = type;
-    m_origin = Vector(origin[0], origin[1], origin[2]);
+    m_origin = origin ? Vector(origin[0], origin[1], origin[2]) : Vector(0.0f, 0.0f, 0.0f);
+    m_hasOrigin = origin;
     m_edict = edict;
 }
 
+bool Message::hasOrigin() const
+{
+    return m_hasOrigin;
+}
+
 void Message::exec() const
 {
-    MESSAGE_BEGIN(msgDestToInt(m_dest), m_type, m_origin, *m_edict);
+    const float *origin = m_hasOrigin ? static_cast<const float *>(m_origin) : nullptr;
+    MESSAGE_BEGIN(msgDestToInt(m_dest), m_type, origin, m_edict ? static_cast<edict_t *>(*m_edict) : nullptr);
 
-    for (auto param : m_params)
+    for (const auto &param : m_params)
     {
         switch (param.type)
         {
             case MsgParamType::Byte:
-                WRITE_BYTE(std::get<int>(param.data));
+                WRITE_BYTE(param.integer);
                 break;
             case MsgParamType::Char:
-                WRITE_CHAR(std::get<int>(param.data));
+                WRITE_CHAR(param.integer);
                 break;
             case MsgParamType::Short:
-                WRITE_SHORT(std::get<int>(param.data));
+                WRITE_SHORT(param.integer);
                 break;
             case MsgParamType::Long:
-                WRITE_LONG(std::get<int>(param.data));
+                WRITE_LONG(param.integer);
                 break;
             case MsgParamType::Angle:
-                WRITE_ANGLE(std::get<float>(param.data));
+                WRITE_ANGLE(param.real);
                 break;
             case MsgParamType::Coord:
-                WRITE_COORD(std::get<float>(param.data));
+                WRITE_COORD(param.real);
                 break;
             case MsgParamType::String:
-                WRITE_STRING(std::get<std::string>(param.data).c_str());
+                WRITE_STRING(m_strings.data() + param.stringOffset);
                 break;
             case MsgParamType::Entity:
-                WRITE_ENTITY(std::get<int>(param.data));
+                WRITE_ENTITY(param.integer);
                 break;
         }
     }
@@ -81,46 +130,67 @@ void Message::exec() const
 void Message::clearParams()
 {
     m_params.clear();
+    m_strings.clear();
 }
 
 int Message::getParamInt(std::size_t index) const
 {
-    return getParam<int>(index);
+    return m_params[index].integer;
 }
 float Message::getParamFloat(std::size_t index) const
 {
-    return getParam<float>(index);
+    return m_params[index].real;
 }
 std::string_view Message::getParamString(std::size_t index) const
 {
-    return getParam<std::string>(index);
+    const Param &param = m_params[index];
+
+    if (param.type != MsgParamType::String)
+        return {};
+
+    return {m_strings.data() + param.stringOffset, param.stringLength};
 }
 
 void Message::setParamInt(std::size_t index, int value)
 {
-    setParam(index, value);
+    m_params[index].integer = value;
 }
 void Message::setParamFloat(std::size_t index, float value)
 {
-    setParam(index, value);
+    m_params[index].real = value;
 }
 void Message::setParamString(std::size_t index, std::string_view string)
 {
-    setParam(index, string.data());
+    Param &param = m_params[index];
+
+    // Previous string stays in the arena until the message is done
+    param.stringOffset = _storeString(string);
+    param.stringLength = static_cast<std::uint32_t>(string.length());
 }
 
-void Message::addParam(MsgParamType type, std::variant<int, float, std::string> &&data)
+void Message::addParam(MsgParamType type, int value)
 {
-    Param param;
-    param.type = type;
-    param.data = data;
+    m_params.push_back({type, value, 0.0f, 0, 0});
+}
 
-    m_params.push_back(param);
+void Message::addParam(MsgParamType type, float value)
+{
+    m_params.push_back({type, 0, value, 0, 0});
 }
 
-void Message::setParam(std::size_t index, std::variant<int, float, std::string> &&data)
+void Message::addParam(MsgParamType type, std::string_view string)
 {
-    m_params[index].data = data;
+    m_params.push_back({type, 0, 0.0f, _storeString(string), static_cast<std::uint32_t>(string.length())});
+}
+
+std::uint32_t Message::_storeString(std::string_view string)
+{
+    auto offset = static_cast<std::uint32_t>(m_strings.size());
+
+    m_strings.insert(m_strings.end(), string.begin(), string.end());
+    m_strings.push_back('\0');
+
+    return offset;
 }
 
 std::size_t Message::getParams() const
@@ -153,19 +223,127 @@ Engine::IEdict *Message::getEdict() const
     return m_edict;
 }
 
-MessageHook::MessageHook(int msgType, Message::Handler handler, HookType hookType)
-    : m_msgType(msgType), m_handler(handler), m_hookType(hookType), m_active(true)
+MessageTemplate::MessageTemplate(int msgType) : m_msgType(msgType) {}
+
+int MessageTemplate::getMsgType() const
+{
+    return m_msgType;
+}
+
+void MessageTemplate::addParam(MsgParamType type, int value)
+{
+    m_params.push_back({type, value, static_cast<float>(value), 0, 0});
+}
+
+void MessageTemplate::addParam(MsgParamType type, float value)
+{
+    m_params.push_back({type, static_cast<int>(value), value, 0, 0});
+}
+
+void MessageTemplate::addParam(MsgParamType type, std::string_view value)
+{
+    auto offset = static_cast<std::uint32_t>(m_strings.size());
+
+    m_strings.insert(m_strings.end(), value.begin(), value.end());
+    m_strings.push_back('\0');
+
+    m_params.push_back({type, 0, 0.0f, offset, static_cast<std::uint32_t>(value.length())});
+}
+
+std::size_t MessageTemplate::addSlot(MsgParamType type, std::string_view name)
+{
+    if (getSlot(name) != INVALID_SLOT)
+        return INVALID_SLOT;
+
+    m_slots.push_back({std::string(name), m_params.size()});
+    m_params.push_back({type, 0, 0.0f, 0, 0});
+
+    return m_slots.size() - 1;
+}
+
+std::size_t MessageTemplate::getSlot(std::string_view name) const
+{
+    for (std::size_t i = 0; i < m_slots.size(); i++)
+    {
+        if (m_slots[i].name == name)
+            return i;
+    }
+
+    return INVALID_SLOT;
+}
+
+std::size_t MessageTemplate::getSlots() const
+{
+    return m_slots.size();
+}
+
+MsgParamType MessageTemplate::getSlotType(std::size_t slot) const
+{
+    return m_params[m_slots[slot].param].type;
+}
+
+bool MessageTemplate::write(const MsgSlotValue *values, std::size_t count, bool hookable) const
+{
+    // Hookable writes go through metamod, so other plugins can see them
+    const Engine::Funcs *funcs = gSPGlobal->getEngine()->getFuncs(hookable);
+    std::size_t slot = 0;
+
+    for (std::size_t i = 0; i < m_params.size(); i++)
+    {
+        const Message::Param &param = m_params[i];
+
+        if (slot >= count || m_slots[slot].param != i)
+        {
+            // Stored strings are null terminated, string params added as numbers are sent empty
+            std::string_view string = "";
+            if (param.type == MsgParamType::String && !m_strings.empty())
+                string = {m_strings.data() + param.stringOffset, param.stringLength};
+
+            writeParam(funcs, param.type, param.integer, param.real, string);
+            continue;
+        }
+
+        const MsgSlotValue &value = values[slot++];
+
+        if (const auto *string = std::get_if<std::string_view>(&value))
+        {
+            writeParam(funcs, param.type, 0, 0.0f, *string);
+        }
+        else if (const auto *integer = std::get_if<int>(&value))
+        {
+            writeParam(funcs, param.type, *integer, static_cast<float>(*integer), {});
+        }
+        else
+        {
+            float real = std::get<float>(value);
+            writeParam(funcs, param.type, static_cast<int>(real), real, {});
+        }
+    }
+
+    return true;
+}
+
+MessageHook::MessageHook(int msgType, Message::Handler handler, HookType hookType, bool observer)
+    : m_msgType(msgType), m_handler(handler), m_hookType(hookType), m_active(true), m_observer(observer)
 {
 }
 
 // IMessageHook
 void MessageHook::enable()
 {
+    if (m_active)
+        return;
+
     m_active = true;
+    gSPGlobal->getMessageManager()->updateHookedMessage(m_msgType);
 }
 void MessageHook::disable()
 {
+    if (!m_active)
+        return;
+
     m_active = false;
+    gSPGlobal->getMessageManager()->updateHookedMessage(m_msgType);
 }
 bool MessageHook::isActive() const
 {
@@ -177,6 +355,20 @@ int MessageHook::getMsgType() const
     return m_msgType;
 }
 
+void MessageHook::addCondition(const MsgCondition &condition)
+{
+    if (condition.type == MsgCondition::Type::Dest || condition.type == MsgCondition::Type::Players)
+        m_beginConditions.emplace_back(condition);
+    else
+        m_paramsConditions.emplace_back(condition);
+}
+
+void MessageHook::clearConditions()
+{
+    m_beginConditions.clear();
+    m_paramsConditions.clear();
+}
+
 // MessageHook
 HookType MessageHook::getHookType() const
 {
@@ -193,18 +385,100 @@ bool MessageHook::getActive() const
     return m_active;
 }
 
-MessageHook *MessageHooks::addHook(int msgType, Message::Handler handler, HookType hookType)
+bool MessageHook::isObserver() const
 {
-    return m_handlers.emplace_back(std::make_unique<MessageHook>(msgType, handler, hookType)).get();
+    return m_observer;
+}
+
+bool MessageHook::checkBeginConditions(MsgDest dest, int receiver) const
+{
+    for (const auto &condition : m_beginConditions)
+    {
+        if (condition.type == MsgCondition::Type::Dest)
+        {
+            if (condition.dest != dest)
+                return false;
+        }
+        else if (receiver < 1 || receiver > static_cast<int>(MAX_PLAYERS) ||
+                 !(condition.players & (1U << (receiver - 1))))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool MessageHook::checkParamsConditions(const Message *message) const
+{
+    for (const auto &condition : m_paramsConditions)
+    {
+        if (condition.param >= message->getParams())
+            return false;
+
+        MsgParamType paramType = message->getParamType(condition.param);
+
+        if (condition.type == MsgCondition::Type::ParamString)
+        {
+            if (paramType != MsgParamType::String || message->getParamString(condition.param) != condition.string)
+                return false;
+
+            continue;
+        }
+
+        if (paramType == MsgParamType::String)
+            return false;
+
+        // Compare as floats only for params which are floats
+        int compared;
+        if (paramType == MsgParamType::Angle || paramType == MsgParamType::Coord)
+        {
+            float value = message->getParamFloat(condition.param);
+            compared = (value < condition.real) ? -1 : (value > condition.real);
+        }
+        else
+        {
+            int value = message->getParamInt(condition.param);
+            compared = (value < condition.value) ? -1 : (value > condition.value);
+        }
+
+        switch (condition.type)
+        {
+            case MsgCondition::Type::ParamEquals:
+                if (compared != 0)
+                    return false;
+                break;
+            case MsgCondition::Type::ParamLess:
+                if (compared >= 0)
+                    return false;
+                break;
+            case MsgCondition::Type::ParamGreater:
+                if (compared <= 0)
+                    return false;
+                break;
+            default:
+                break;
+        }
+    }
+
+    return true;
+}
+
+MessageHook *MessageHooks::addHook(int msgType, Message::Handler handler, HookType hookType, bool observer)
+{
+    auto hook = std::make_unique<MessageHook>(msgType, handler, hookType, observer);
+    return _getList(hook.get()).emplace_back(std::move(hook)).get();
 }
 void MessageHooks::removeHook(IMessageHook *hook)
 {
-    auto iter = m_handlers.begin();
-    while (iter != m_handlers.end())
+    HookList &hooks = _getList(static_cast<MessageHook *>(hook));
+
+    auto iter = hooks.begin();
+    while (iter != hooks.end())
     {
         if ((*iter).get() == hook)
         {
-            m_handlers.erase(iter);
+            hooks.erase(iter);
             break;
         }
         ++iter;
@@ -213,10 +487,13 @@ void MessageHooks::removeHook(IMessageHook *hook)
 IForward::ReturnValue MessageHooks::exec(const std::unique_ptr<Message> &message, HookType hookType) const
 {
     IForward::ReturnValue result = IForward::ReturnValue::Ignored;
+    Engine::IEdict *edict = message->getEdict();
+    int receiver = edict ? static_cast<int>(edict->getIndex()) : 0;
 
-    for (const auto &hook : m_handlers)
+    for (const auto &hook : (hookType == HookType::Pre) ? m_preHooks : m_postHooks)
     {
-        if (!hook->getActive() || hook->getHookType() != hookType)
+        if (!hook->getActive() || !hook->checkBeginConditions(message->getDest(), receiver) ||
+            !hook->checkParamsConditions(message.get()))
         {
             continue;
         }
@@ -238,19 +515,427 @@ IForward::ReturnValue MessageHooks::exec(const std::unique_ptr<Message> &message
     return result;
 }
 
-bool MessageHooks::hasHooks() const
+void MessageHooks::execObservers(const std::unique_ptr<Message> &message) const
 {
-    return !m_handlers.empty();
+    Engine::IEdict *edict = message->getEdict();
+    int receiver = edict ? static_cast<int>(edict->getIndex()) : 0;
+
+    for (const auto &hook : m_observers)
+    {
+        if (!hook->getActive() || !hook->checkBeginConditions(message->getDest(), receiver) ||
+            !hook->checkParamsConditions(message.get()))
+        {
+            continue;
+        }
+
+        hook->getHandler()(message.get());
+    }
+}
+
+bool MessageHooks::hasActiveHooks() const
+{
+    return _hasActive(m_preHooks) || _hasActive(m_postHooks);
+}
+
+bool MessageHooks::hasActiveObservers() const
+{
+    return _hasActive(m_observers);
+}
+
+bool MessageHooks::shouldIntercept(MsgDest dest, int receiver) const
+{
+    return _canExec(m_preHooks, dest, receiver) || _canExec(m_postHooks, dest, receiver);
+}
+
+bool MessageHooks::shouldObserve(MsgDest dest, int receiver) const
+{
+    return _canExec(m_observers, dest, receiver);
 }
 
 void MessageHooks::clearHooks()
 {
-    m_handlers.clear();
+    m_preHooks.clear();
+    m_postHooks.clear();
+    m_observers.clear();
+}
+
+bool MessageHooks::_hasActive(const HookList &hooks)
+{
+    return std::any_of(hooks.begin(), hooks.end(), [](const auto &hook) { return hook->getActive(); });
+}
+
+bool MessageHooks::_canExec(const HookList &hooks, MsgDest dest, int receiver)
+{
+    for (const auto &hook : hooks)
+    {
+        if (hook->getActive() && hook->checkBeginConditions(dest, receiver))
+            return true;
+    }
+
+    return false;
+}
+
+MessageHooks::HookList &MessageHooks::_getList(const MessageHook *hook)
+{
+    if (hook->isObserver())
+        return m_observers;
+
+    return (hook->getHookType() == HookType::Pre) ? m_preHooks : m_postHooks;
+}
+
+MessageStats::MessageStats()
+    : m_slices(), m_pending(false), m_type(0), m_dest(MsgDest::BROADCAST), m_receiver(0), m_bytes(0)
+{
+    reset();
+}
+
+std::uint32_t MessageStats::getParamSize(MsgParamType type)
+{
+    switch (type)
+    {
+        case MsgParamType::Byte:
+        case MsgParamType::Char:
+        case MsgParamType::Angle:
+            return 1;
+        case MsgParamType::Short:
+        case MsgParamType::Coord:
+        case MsgParamType::Entity:
+            return 2;
+        case MsgParamType::Long:
+            return 4;
+        default:
+            return 0;
+    }
 }
 
-MessageMngr::MessageMngr() : m_message(std::make_unique<Message>())
+void MessageStats::begin(int type, MsgDest dest, int receiver)
 {
+    m_pending = true;
+    m_type = type;
+    m_dest = dest;
+    m_receiver = receiver;
+
+    // Message id, user messages have their size as well
+    m_bytes = (type >= 64) ? 2 : 1;
+}
+
+void MessageStats::end()
+{
+    if (!m_pending)
+        return;
+
+    m_pending = false;
+
+    std::int64_t id = _getSliceId();
+    Slice &slice = m_slices[static_cast<std::size_t>(id) % WINDOW_SLICES];
+
+    // Slice is older than the window, start it over
+    if (slice.id != id)
+    {
+        slice.id = id;
+        slice.counters = {};
+    }
+
+    MsgStats &counters = slice.counters;
+    _add(counters.types[m_type], m_bytes);
+    _add(counters.dests[static_cast<std::size_t>(m_dest)], m_bytes);
+
+    switch (m_dest)
+    {
+        case MsgDest::ONE:
+        case MsgDest::ONE_UNRELIABLE:
+            if (m_receiver >= 1 && m_receiver <= static_cast<int>(MAX_PLAYERS))
+                _add(counters.players[m_receiver], m_bytes);
+            break;
+        case MsgDest::BROADCAST:
+        case MsgDest::ALL:
+        {
+            PlayerMngr *plrMngr = gSPGlobal->getPlayerManager();
+            std::uint32_t maxClients = std::min(plrMngr->getMaxClients(), MAX_PLAYERS);
+
+            for (std::uint32_t i = 1; i <= maxClients; i++)
+            {
+                Player *player = plrMngr->getPlayer(i);
+                if (player && player->isConnected())
+                    _add(counters.players[i], m_bytes);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void MessageStats::cancel()
+{
+    m_pending = false;
+}
+
+void MessageStats::get(MsgStats &stats) const
+{
+    stats = {};
+
+    std::int64_t current = _getSliceId();
+
+    for (const auto &slice : m_slices)
+    {
+        if (slice.id <= current - static_cast<std::int64_t>(WINDOW_SLICES))
+            continue;
+
+        for (std::size_t i = 0; i < MAX_USER_MESSAGES; i++)
+        {
+            stats.types[i].messages += slice.counters.types[i].messages;
+            stats.types[i].bytes += slice.counters.types[i].bytes;
+        }
+        for (std::size_t i = 0; i < MAX_MSG_DESTS; i++)
+        {
+            stats.dests[i].messages += slice.counters.dests[i].messages;
+            stats.dests[i].bytes += slice.counters.dests[i].bytes;
+        }
+        for (std::size_t i = 0; i <= MAX_PLAYERS; i++)
+        {
+            stats.players[i].messages += slice.counters.players[i].messages;
+            stats.players[i].bytes += slice.counters.players[i].bytes;
+        }
+    }
+}
+
+void MessageStats::reset()
+{
+    for (auto &slice : m_slices)
+    {
+        slice.id = -1;
+        slice.counters = {};
+    }
+
+    m_pending = false;
+}
+
+void MessageStats::dump(const Logger *logger) const
+{
+    static constexpr std::size_t nameWidth = 20;
+    static constexpr std::size_t numWidth = 12;
+    static constexpr const char *destNames[MAX_MSG_DESTS] = {"BROADCAST", "ONE", "ALL", "INIT", "PVS",
+                                                             "PAS", "PVS_R", "PAS_R", "ONE_UNRELIABLE", "SPEC"};
+
+    MsgStats stats;
+    get(stats);
+
+    std::vector<std::size_t> types;
+    for (std::size_t i = 0; i < MAX_USER_MESSAGES; i++)
+    {
+        if (stats.types[i].messages)
+            types.push_back(i);
+    }
+
+    std::sort(types.begin(), types.end(),
+              [&stats](std::size_t lhs, std::size_t rhs) { return stats.types[lhs].bytes > stats.types[rhs].bytes; });
+
+    Metamod::Funcs *metaFuncs = gSPGlobal->getMetamod()->getFuncs();
+
+    logger->sendMsgToConsoleInternal("\nMessages sent over the last second");
+    logger->sendMsgToConsoleInternal(std::left, std::setw(nameWidth), "message", std::right, std::setw(numWidth),
+                                     "id", std::setw(numWidth), "messages", std::setw(numWidth), "bytes");
+
+    for (std::size_t type : types)
+    {
+        // Engine messages do not have names
+        std::string_view name = (type >= 64) ? metaFuncs->getUsrMsgName(static_cast<std::uint32_t>(type)) : "";
+        logger->sendMsgToConsoleInternal(std::left, std::setw(nameWidth), name.substr(0, nameWidth - 1), std::right,
+                                         std::setw(numWidth), type, std::setw(numWidth), stats.types[type].messages,
+                                         std::setw(numWidth), stats.types[type].bytes);
+    }
+
+    logger->sendMsgToConsoleInternal(std::left, std::setw(nameWidth), "\ndest", std::right, std::setw(numWidth),
+                                     "messages", std::setw(numWidth), "bytes");
+
+    for (std::size_t i = 0; i < MAX_MSG_DESTS; i++)
+    {
+        if (!stats.dests[i].messages)
+            continue;
+
+        logger->sendMsgToConsoleInternal(std::left, std::setw(nameWidth), destNames[i], std::right,
+                                         std::setw(numWidth), stats.dests[i].messages, std::setw(numWidth),
+                                         stats.dests[i].bytes);
+    }
+
+    logger->sendMsgToConsoleInternal(std::left, std::setw(nameWidth), "\nplayer", std::right, std::setw(numWidth),
+                                     "messages", std::setw(numWidth), "bytes");
+
+    for (std::size_t i = 1; i <= MAX_PLAYERS; i++)
+    {
+        if (!stats.players[i].messages)
+            continue;
+
+        logger->sendMsgToConsoleInternal(std::left, std::setw(nameWidth), i, std::right, std::setw(numWidth),
+                                         stats.players[i].messages, std::setw(numWidth), stats.players[i].bytes);
+    }
+}
+
+std::int64_t MessageStats::_getSliceId()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(now).count() / SLICE_LENGTH.count();
+}
+
+void MessageStats::_add(MsgStats::Counter &counter, std::uint32_t bytes)
+{
+    counter.messages++;
+    counter.bytes += bytes;
+}
+
+bool MessageRecorder::start(const fs::path &path)
+{
+    stop();
+
+    m_file.open(path, std::ios::binary | std::ios::out | std::ios::app);
+    if (!m_file)
+        return false;
+
+    // Header is written only once, recordings can be continued
+    if (m_file.tellp() == 0)
+    {
+        _write(MAGIC);
+        _write(VERSION);
+    }
+
+    return true;
+}
+
+void MessageRecorder::stop()
+{
+    if (m_file.is_open())
+        m_file.close();
+}
+
+bool MessageRecorder::isRecording() const
+{
+    return m_file.is_open();
+}
+
+void MessageRecorder::record(const Message *message)
+{
+    Engine::IEdict *edict = message->getEdict();
+    const float *origin = message->getOrigin();
+
+    _write(static_cast<std::uint8_t>(message->getDest()));
+    _write(static_cast<std::uint8_t>(message->getType()));
+    _write(static_cast<std::uint8_t>(message->hasOrigin()));
+    _write(origin[0]);
+    _write(origin[1]);
+    _write(origin[2]);
+    _write(static_cast<std::uint16_t>(edict ? edict->getIndex() : 0));
+    _write(static_cast<std::uint8_t>(message->getParams()));
+
+    for (std::size_t i = 0; i < message->getParams(); i++)
+    {
+        MsgParamType type = message->getParamType(i);
+        _write(static_cast<std::uint8_t>(type));
+
+        switch (type)
+        {
+            case MsgParamType::Angle:
+            case MsgParamType::Coord:
+                _write(message->getParamFloat(i));
+                break;
+            case MsgParamType::String:
+            {
+                std::string_view string = message->getParamString(i);
+                _write(static_cast<std::uint16_t>(string.length()));
+                m_file.write(string.data(), static_cast<std::streamsize>(string.length()));
+                break;
+            }
+            default:
+                _write(static_cast<std::int32_t>(message->getParamInt(i)));
+                break;
+        }
+    }
+}
+
+bool MessageRecorder::readHeader(std::istream &stream)
+{
+    std::uint32_t magic;
+    std::uint16_t version;
+
+    return _read(stream, magic) && _read(stream, version) && magic == MAGIC && version == VERSION;
+}
+
+bool MessageRecorder::read(std::istream &stream, Message *message)
+{
+    std::uint8_t dest, type, hasOrigin, params;
+    std::uint16_t edictIndex;
+    float origin[3];
+
+    if (!_read(stream, dest) || !_read(stream, type) || !_read(stream, hasOrigin) || !_read(stream, origin[0]) ||
+        !_read(stream, origin[1]) || !_read(stream, origin[2]) || !_read(stream, edictIndex) || !_read(stream, params))
+    {
+        return false;
+    }
+
+    if (dest >= MAX_MSG_DESTS || params > Message::MAX_PARAMS)
+        return false;
+
+    Engine::Edict *edict = edictIndex ? gSPGlobal->getEngine()->getEdict(edictIndex) : nullptr;
+
+    message->clearParams();
+    message->init(intToMsgDest(dest), type, hasOrigin ? origin : nullptr, edict);
+
+    // Reused between params, keeps its capacity
+    static std::string string;
+
+    for (std::uint8_t i = 0; i < params; i++)
+    {
+        std::uint8_t paramType;
+        if (!_read(stream, paramType) || paramType > static_cast<std::uint8_t>(MsgParamType::Entity))
+            return false;
+
+        switch (static_cast<MsgParamType>(paramType))
+        {
+            case MsgParamType::Angle:
+            case MsgParamType::Coord:
+            {
+                float value;
+                if (!_read(stream, value))
+                    return false;
+
+                message->addParam(static_cast<MsgParamType>(paramType), value);
+                break;
+            }
+            case MsgParamType::String:
+            {
+                std::uint16_t length;
+                if (!_read(stream, length))
+                    return false;
+
+                string.resize(length);
+                if (!stream.read(string.data(), length))
+                    return false;
+
+                message->addParam(MsgParamType::String, std::string_view(string));
+                break;
+            }
+            default:
+            {
+                std::int32_t value;
+                if (!_read(stream, value))
+                    return false;
+
+                message->addParam(static_cast<MsgParamType>(paramType), static_cast<int>(value));
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+MessageMngr::MessageMngr() : m_message(std::make_unique<Message>()), m_observed(std::make_unique<Message>())
+{
+    m_inhook = false;
     m_inblock = false;
+    m_observing = false;
+    m_inobserver = false;
+    m_statsEnabled = false;
 
     for (std::size_t i = 0; i < MAX_USER_MESSAGES; i++)
     {
@@ -260,13 +945,25 @@ MessageMngr::MessageMngr() : m_message(std::make_unique<Message>())
 
 MessageHook *MessageMngr::registerHook(int msgType, Message::Handler handler, HookType hookType)
 {
-    return m_hooks[msgType].addHook(msgType, handler, hookType);
+    MessageHook *hook = m_hooks[msgType].addHook(msgType, handler, hookType);
+    updateHookedMessage(msgType);
+
+    return hook;
+}
+
+MessageHook *MessageMngr::registerObserver(int msgType, Message::Handler handler)
+{
+    MessageHook *hook = m_hooks[msgType].addHook(msgType, handler, HookType::Post, true);
+    updateHookedMessage(msgType);
+
+    return hook;
 }
 
 void MessageMngr::unregisterHook(IMessageHook *hook)
 {
     int msgType = hook->getMsgType();
     m_hooks[msgType].removeHook(hook);
+    updateHookedMessage(msgType);
 }
 
 MsgBlockType MessageMngr::getMessageBlock(int msgType) const
@@ -286,7 +983,7 @@ IForward::ReturnValue MessageMngr::execHandlers(HookType hookType)
 
 bool MessageMngr::inHook() const
 {
-    return m_inhook;
+    return m_inhook || m_inobserver;
 }
 
 void MessageMngr::clearMessages()
@@ -295,6 +992,128 @@ void MessageMngr::clearMessages()
     {
         m_hooks[i].clearHooks();
     }
+
+    m_hookedMsgs.reset();
+    m_observedMsgs.reset();
+    m_templates.clear();
+}
+
+MessageTemplate *MessageMngr::createTemplate(int msgType)
+{
+    // Engine drops the server when it is asked to send an unregistered message
+    if (msgType < 1 || static_cast<std::size_t>(msgType) >= MAX_USER_MESSAGES)
+        return nullptr;
+
+    if (msgType > 63 && gSPGlobal->getMetamod()->getFuncs()->getUsrMsgName(msgType).empty())
+        return nullptr;
+
+    return m_templates.emplace_back(std::make_unique<MessageTemplate>(msgType)).get();
+}
+
+void MessageMngr::destroyTemplate(IMessageTemplate *msgTemplate)
+{
+    auto iter = std::find_if(m_templates.begin(), m_templates.end(),
+                             [msgTemplate](const auto &ptr) { return ptr.get() == msgTemplate; });
+
+    if (iter != m_templates.end())
+        m_templates.erase(iter);
+}
+
+bool MessageMngr::sendTemplate(const IMessageTemplate *msgTemplate,
+                               MsgDest dest,
+                               const float *origin,
+                               Engine::IEdict *target,
+                               const MsgSlotValue *values,
+                               std::size_t count,
+                               bool hookable)
+{
+    if (count != msgTemplate->getSlots())
+        return false;
+
+    // String values are accepted only by string slots and the other way around
+    for (std::size_t i = 0; i < count; i++)
+    {
+        bool isString = std::holds_alternative<std::string_view>(values[i]);
+        if (isString != (msgTemplate->getSlotType(i) == MsgParamType::String))
+            return false;
+    }
+
+    const Engine::Funcs *funcs = gSPGlobal->getEngine()->getFuncs(hookable);
+
+    funcs->messageBegin(dest, static_cast<std::uint32_t>(msgTemplate->getMsgType()), origin, target);
+    static_cast<const MessageTemplate *>(msgTemplate)->write(values, count, hookable);
+    funcs->messageEnd();
+
+    return true;
+}
+
+void MessageMngr::setStatsEnabled(bool enable)
+{
+    if (enable && !m_statsEnabled)
+        m_stats.reset();
+
+    m_statsEnabled = enable;
+}
+
+bool MessageMngr::isStatsEnabled() const
+{
+    return m_statsEnabled;
+}
+
+void MessageMngr::getStats(MsgStats &stats) const
+{
+    m_stats.get(stats);
+}
+
+bool MessageMngr::startRecording(const fs::path &path)
+{
+    return m_recorder.start(path);
+}
+
+void MessageMngr::stopRecording()
+{
+    m_recorder.stop();
+}
+
+bool MessageMngr::isRecording() const
+{
+    return m_recorder.isRecording();
+}
+
+std::size_t MessageMngr::replayMessages(const fs::path &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file || !MessageRecorder::readHeader(file))
+        return 0;
+
+    std::size_t count = 0;
+
+    // Natives reading message params work the same as in a live hook
+    m_inhook = true;
+
+    while (MessageRecorder::read(file, m_message.get()))
+    {
+        const MessageHooks &hooks = m_hooks[m_message->getType()];
+
+        if (hooks.exec(m_message, HookType::Pre) == IForward::ReturnValue::Ignored)
+        {
+            hooks.exec(m_message, HookType::Post);
+            hooks.execObservers(m_message);
+        }
+
+        count++;
+    }
+
+    m_inhook = false;
+    m_message->clearParams();
+
+    return count;
+}
+
+void MessageMngr::updateHookedMessage(int msgType)
+{
+    m_hookedMsgs.set(msgType, m_hooks[msgType].hasActiveHooks());
+    m_observedMsgs.set(msgType, m_hooks[msgType].hasActiveObservers());
 }
 
 META_RES MessageMngr::MessageBegin(int msg_dest, int msg_type, const float *pOrigin, edict_t *ed)
@@ -306,14 +1125,41 @@ META_RES MessageMngr::MessageBegin(int msg_dest, int msg_type, const float *pOri
         return MRES_SUPERCEDE;
     }
 
-    m_inhook = m_hooks[msg_type].hasHooks();
+    if (m_statsEnabled)
+        m_stats.begin(msg_type, intToMsgDest(msg_dest), ed ? ENTINDEX(ed) : 0);
+
+    // Messages without active hooks go straight to the engine
+    bool hooked = m_hookedMsgs.test(msg_type);
+    bool recording = m_recorder.isRecording();
+    if (!hooked && !recording && !m_observedMsgs.test(msg_type))
+    {
+        m_inhook = false;
+        m_observing = false;
+        return MRES_IGNORED;
+    }
+
+    // So do messages which no hook is interested in
+    MsgDest dest = intToMsgDest(msg_dest);
+    int receiver = ed ? ENTINDEX(ed) : 0;
+    m_inhook = hooked && m_hooks[msg_type].shouldIntercept(dest, receiver);
 
     if (m_inhook)
     {
-        m_message->init(intToMsgDest(msg_dest), msg_type, pOrigin, gSPGlobal->getEngine()->getEdict(ed));
+        m_message->init(dest, msg_type, pOrigin, gSPGlobal->getEngine()->getEdict(ed));
         return MRES_SUPERCEDE;
     }
 
+    // Only observers, let the engine have the message and record it alongside
+    // Recorder captures these the same way as observers do
+    m_observing = !m_inobserver && (recording || (m_observedMsgs.test(msg_type) &&
+                                                  m_hooks[msg_type].shouldObserve(dest, receiver)));
+
+    if (m_observing)
+    {
+        m_observed->clearParams();
+        m_observed->init(dest, msg_type, pOrigin, gSPGlobal->getEngine()->getEdict(ed));
+    }
+
     return MRES_IGNORED;
 }
 
@@ -331,11 +1177,16 @@ META_RES MessageMngr::MessageEnd()
 
     if (!m_inhook)
     {
+        if (m_statsEnabled)
+            m_stats.end();
+
         return MRES_IGNORED;
     }
 
-    // exec pre hooks
-    // add contidions for hooks like in amxx events
+    if (m_recorder.isRecording())
+        m_recorder.record(m_message.get());
+
+    // exec pre hooks, only the ones which conditions are met
 
     IForward::ReturnValue ret = execHandlers(HookType::Pre);
 
@@ -345,13 +1196,34 @@ META_RES MessageMngr::MessageEnd()
     {
         m_message->exec();
 
+        if (m_statsEnabled)
+            m_stats.end();
+
         // exec post hooks?
         execHandlers(HookType::Post);
+        m_hooks[m_message->getType()].execObservers(m_message);
     }
 
     m_inhook = false;
 
     m_message->clearParams();
+    m_stats.cancel();
 
     return MRES_SUPERCEDE;
 }
+
+void MessageMngr::MessageEndPost()
+{
+    if (!m_observing)
+        return;
+
+    m_observing = false;
+    m_inobserver = true;
+
+    if (m_recorder.isRecording())
+        m_recorder.record(m_observed.get());
+
+    m_hooks[m_observed->getType()].execObservers(m_observed);
+
+    m_inobserver = false;
+}
@@ -24,13 +24,23 @@
 class Message : public IMessage
 {
 public:
+    /* Engine limits message payload to 192 bytes, so there cannot be more params */
+    static constexpr std::size_t MAX_PARAMS = 192;
+
+    /* Storage reserved upfront for strings, enough for the longest message */
+    static constexpr std::size_t STRINGS_RESERVED_SIZE = 1024;
+
+    /* Flat param record, strings are kept in the strings arena */
     struct Param
     {
         MsgParamType type;
-        std::variant<int, float, std::string> data;
+        int integer;
+        float real;
+        std::uint32_t stringOffset;
+        std::uint32_t stringLength;
     };
 
-    Message() = default;
+    Message();
     ~Message() = default;
 
     // IMessage
@@ -51,43 +61,72 @@ public:
     Engine::IEdict *getEdict() const override;
 
     // Message
+    /* Origin can be nullptr, getOrigin() returns zero vector then */
     void init(MsgDest dest, int type, const float *origin, Engine::Edict *edict);
+    bool hasOrigin() const;
 
     void exec() const;
 
     void clearParams();
 
-    void addParam(MsgParamType type, std::variant<int, float, std::string> &&data);
-
-    void setParam(std::size_t index, std::variant<int, float, std::string> &&data);
-
-    template<typename T>
-    const T &getParam(std::size_t index) const
-    {
-        try
-        {
-            return std::get<T>(m_params[index].data);
-        }
-        catch (const std::bad_variant_access &e [[maybe_unused]])
-        {
-            static T empty;
-            return empty;
-        }
-    }
+    void addParam(MsgParamType type, int value);
+    void addParam(MsgParamType type, float value);
+    void addParam(MsgParamType type, std::string_view string);
 
 private:
+    /* Copies string to the arena, returns its offset */
+    std::uint32_t _storeString(std::string_view string);
+
     MsgDest m_dest;
     int m_type;
     Vector m_origin;
+    bool m_hasOrigin;
     Engine::Edict *m_edict;
 
+    /* Both keep their capacity between messages */
     std::vector<Param> m_params;
+    std::vector<char> m_strings;
+};
+
+class MessageTemplate final : public IMessageTemplate
+{
+public:
+    struct Slot
+    {
+        std::string name;
+        std::size_t param;
+    };
+
+    explicit MessageTemplate(int msgType);
+    ~MessageTemplate() = default;
+
+    // IMessageTemplate
+    int getMsgType() const override;
+    void addParam(MsgParamType type, int value) override;
+    void addParam(MsgParamType type, float value) override;
+    void addParam(MsgParamType type, std::string_view value) override;
+    std::size_t addSlot(MsgParamType type, std::string_view name) override;
+    std::size_t getSlot(std::string_view name) const override;
+    std::size_t getSlots() const override;
+    MsgParamType getSlotType(std::size_t slot) const override;
+
+    // MessageTemplate
+    /* Writes params of the template, slots are filled from values */
+    bool write(const MsgSlotValue *values, std::size_t count, bool hookable) const;
+
+private:
+    int m_msgType;
+
+    /* Params in message order, slot params are placeholders */
+    std::vector<Message::Param> m_params;
+    std::vector<char> m_strings;
+    std::vector<Slot> m_slots;
 };
 
 class MessageHook final : public IMessageHook
 {
 public:
-    MessageHook(int msgType, Message::Handler handler, HookType hookType);
+    MessageHook(int msgType, Message::Handler handler, HookType hookType, bool observer = false);
     ~MessageHook() = default;
 
     // IMessageHook
@@ -95,17 +134,35 @@ public:
     void disable() override;
     bool isActive() const override;
     int getMsgType() const override;
+    void addCondition(const MsgCondition &condition) override;
+    void clearConditions() override;
 
     // MessageHook
     HookType getHookType() const;
     Message::Handler getHandler() const;
     bool getActive() const;
+    bool isObserver() const;
+
+    /* Checks conditions known when message begins */
+    bool checkBeginConditions(MsgDest dest, int receiver) const;
+
+    /* Checks conditions on captured params */
+    bool checkParamsConditions(const Message *message) const;
 
 private:
     int m_msgType;
     Message::Handler m_handler;
     HookType m_hookType;
     bool m_active;
+
+    /* Read-only hook, message is not intercepted for it */
+    bool m_observer;
+
+    /* Dest and players conditions */
+    std::vector<MsgCondition> m_beginConditions;
+
+    /* Conditions on params */
+    std::vector<MsgCondition> m_paramsConditions;
 };
 
 class MessageHooks
@@ -114,18 +171,115 @@ public:
     MessageHooks() = default;
     ~MessageHooks() = default;
 
-    MessageHook *addHook(int msgType, Message::Handler handler, HookType hookType);
+    MessageHook *addHook(int msgType, Message::Handler handler, HookType hookType, bool observer = false);
 
     void removeHook(IMessageHook *hook);
 
     IForward::ReturnValue exec(const std::unique_ptr<Message> &message, HookType hookType) const;
+    void execObservers(const std::unique_ptr<Message> &message) const;
+
+    /* True if any pre or post hook is enabled */
+    bool hasActiveHooks() const;
+    bool hasActiveObservers() const;
 
-    bool hasHooks() const;
+    /* True if any active hook can be executed for message with this dest and receiver */
+    bool shouldIntercept(MsgDest dest, int receiver) const;
+    bool shouldObserve(MsgDest dest, int receiver) const;
 
     void clearHooks();
 
 private:
-    std::vector<std::unique_ptr<MessageHook>> m_handlers;
+    using HookList = std::vector<std::unique_ptr<MessageHook>>;
+
+    static bool _hasActive(const HookList &hooks);
+    static bool _canExec(const HookList &hooks, MsgDest dest, int receiver);
+
+    HookList &_getList(const MessageHook *hook);
+
+    HookList m_preHooks;
+    HookList m_postHooks;
+    HookList m_observers;
+};
+
+class MessageStats
+{
+public:
+    /* One second window split into slices, the oldest slice is reused */
+    static constexpr std::size_t WINDOW_SLICES = 10;
+    static constexpr std::chrono::milliseconds SLICE_LENGTH = std::chrono::milliseconds(100);
+
+    MessageStats();
+    ~MessageStats() = default;
+
+    static std::uint32_t getParamSize(MsgParamType type);
+
+    void begin(int type, MsgDest dest, int receiver);
+    void addBytes(std::uint32_t bytes)
+    {
+        m_bytes += bytes;
+    }
+    void end();
+    void cancel();
+
+    void get(MsgStats &stats) const;
+    void reset();
+    void dump(const Logger *logger) const;
+
+private:
+    struct Slice
+    {
+        std::int64_t id;
+        MsgStats counters;
+    };
+
+    static std::int64_t _getSliceId();
+    static void _add(MsgStats::Counter &counter, std::uint32_t bytes);
+
+    std::array<Slice, WINDOW_SLICES> m_slices;
+
+    /* Message being written */
+    bool m_pending;
+    int m_type;
+    MsgDest m_dest;
+    int m_receiver;
+    std::uint32_t m_bytes;
+};
+
+class MessageRecorder
+{
+public:
+    /* "SPMR" followed by format version, values are stored in host byte order */
+    static constexpr std::uint32_t MAGIC = 0x524D5053;
+    static constexpr std::uint16_t VERSION = 2;
+
+    MessageRecorder() = default;
+    ~MessageRecorder() = default;
+
+    bool start(const fs::path &path);
+    void stop();
+    bool isRecording() const;
+
+    /* Appends message with its params */
+    void record(const Message *message);
+
+    /* Reads message written by record(), false on end of file or malformed data */
+    static bool readHeader(std::istream &stream);
+    static bool read(std::istream &stream, Message *message);
+
+private:
+    template<typename T>
+    void _write(T value)
+    {
+        m_file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    static bool _read(std::istream &stream, T &value)
+    {
+        return static_cast<bool>(stream.read(reinterpret_cast<char *>(&value), sizeof(T)));
+    }
+
+    std::ofstream m_file;
 };
 
 class MessageMngr : public IMessageMngr
@@ -136,6 +290,7 @@ public:
 
     // IMessageMngr
     MessageHook *registerHook(int msgType, Message::Handler handler, HookType hookType) override;
+    MessageHook *registerObserver(int msgType, Message::Handler handler) override;
     void unregisterHook(IMessageHook *) override;
 
     MsgBlockType getMessageBlock(int msgType) const override;
@@ -145,16 +300,46 @@ public:
 
     IMessage *getMessage() const override
     {
-        return m_message.get();
+        return m_inobserver ? m_observed.get() : m_message.get();
     }
 
     bool inHook() const override;
 
     void clearMessages();
 
+    /* Called when hooks of the message are added, removed, enabled or disabled */
+    void updateHookedMessage(int msgType);
+
+    MessageTemplate *createTemplate(int msgType) override;
+    void destroyTemplate(IMessageTemplate *msgTemplate) override;
+    bool sendTemplate(const IMessageTemplate *msgTemplate,
+                      MsgDest dest,
+                      const float *origin,
+                      Engine::IEdict *target,
+                      const MsgSlotValue *values,
+                      std::size_t count,
+                      bool hookable) override;
+
+    void setStatsEnabled(bool enable) override;
+    bool isStatsEnabled() const override;
+    void getStats(MsgStats &stats) const override;
+
+    const MessageStats &getStatsCounter() const
+    {
+        return m_stats;
+    }
+
+    bool startRecording(const fs::path &path);
+    void stopRecording();
+    bool isRecording() const;
+
+    /* Runs recorded messages through hooks without sending them, returns number of messages */
+    std::size_t replayMessages(const fs::path &path);
+
     META_RES MessageBegin(int msg_dest, int msg_type, const float *pOrigin, edict_t *ed);
 
     META_RES MessageEnd();
+    void MessageEndPost();
 
     template<typename T>
     META_RES WriteParam(MsgParamType type, T value)
@@ -163,20 +348,49 @@ public:
         {
             return MRES_SUPERCEDE;
         }
-        else if (m_inhook)
+
+        if (m_statsEnabled)
+        {
+            if constexpr (std::is_convertible_v<T, std::string_view>)
+                m_stats.addBytes(static_cast<std::uint32_t>(std::string_view(value).length()) + 1);
+            else
+                m_stats.addBytes(MessageStats::getParamSize(type));
+        }
+
+        if (m_inhook)
         {
             m_message->addParam(type, value);
             return MRES_SUPERCEDE;
         }
+        else if (m_observing)
+        {
+            m_observed->addParam(type, value);
+        }
         return MRES_IGNORED;
     }
 
 private:
     std::unique_ptr<Message> m_message;
+
+    /* Message recorded for observers while it is passed to the engine */
+    std::unique_ptr<Message> m_observed;
+
     std::array<MessageHooks, MAX_USER_MESSAGES> m_hooks;
     std::array<MsgBlockType, MAX_USER_MESSAGES> m_blocks;
+    std::vector<std::unique_ptr<MessageTemplate>> m_templates;
+
+    /* Messages with at least one active hook or observer */
+    std::bitset<MAX_USER_MESSAGES> m_hookedMsgs;
+    std::bitset<MAX_USER_MESSAGES> m_observedMsgs;
 
     bool m_inhook;
     bool m_inblock;
+    bool m_observing;
+    bool m_inobserver;
     int m_msgType;
+
+    bool m_statsEnabled;
+    MessageStats m_stats;
+
+    MessageRecorder m_recorder;
 };
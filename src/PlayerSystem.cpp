@@ -268,7 +268,7 @@ bool PlayerMngr::ClientConnect(edict_t *pEntity,
 {
     using sf = IForward::StringFlags;
 
-    Forward *fwdPlrConnect = gSPGlobal->getForwardManager()->getForward(ForwardMngr::FWD_PLAYER_CONNECT);
+    Forward *fwdPlrConnect = gSPGlobal->getForwardManager()->getForward(ForwardMngr::DefaultForward::PlayerConnect);
 
     std::int32_t result;
     fwdPlrConnect->pushInt(ENTINDEX(pEntity));
@@ -299,7 +299,8 @@ void PlayerMngr::ClientConnectPost(edict_t *pEntity, std::string_view pszName, s
     else
         plr->authorize(authid);
 
-    Forward *fwdPlrConnectPost = gSPGlobal->getForwardManager()->getForward(ForwardMngr::FWD_PLAYER_CONNECTED);
+    Forward *fwdPlrConnectPost =
+        gSPGlobal->getForwardManager()->getForward(ForwardMngr::DefaultForward::PlayerConnected);
     fwdPlrConnectPost->pushInt(ENTINDEX(pEntity));
     fwdPlrConnectPost->pushString(pszName);
     fwdPlrConnectPost->pushString(pszAddress);
@@ -310,7 +311,7 @@ void PlayerMngr::ClientPutInServer(edict_t *pEntity)
 {
     Player *plr = getPlayer(pEntity);
 
-    Forward *forward = gSPGlobal->getForwardManager()->getForward(ForwardMngr::FWD_PLAYER_ENTER);
+    Forward *forward = gSPGlobal->getForwardManager()->getForward(ForwardMngr::DefaultForward::PlayerEnter);
     forward->pushInt(plr->getIndex());
     forward->execFunc(nullptr);
 }
@@ -320,7 +321,7 @@ void PlayerMngr::ClientPutInServerPost(edict_t *pEntity)
     Player *plr = getPlayer(pEntity);
     plr->putInServer();
 
-    Forward *forward = gSPGlobal->getForwardManager()->getForward(ForwardMngr::FWD_PLAYER_ENTERED);
+    Forward *forward = gSPGlobal->getForwardManager()->getForward(ForwardMngr::DefaultForward::PlayerEntered);
     forward->pushInt(plr->getIndex());
     forward->execFunc(nullptr);
 }
@@ -30,7 +30,7 @@ static void SV_DropClientHook(IRehldsHook_SV_DropClient *chain, IGameClient *cli
     PlayerMngr *plrMngr = gSPGlobal->getPlayerManager();
     Player *plr = plrMngr->getPlayer(client->GetEdict());
 
-    Forward *forward = gSPGlobal->getForwardManager()->getForward(ForwardMngr::FWD_PLAYER_DISCONNECT);
+    Forward *forward = gSPGlobal->getForwardManager()->getForward(ForwardMngr::DefaultForward::PlayerDisconnect);
     forward->pushInt(plr->basePlayer()->edict()->getIndex());
     forward->pushInt(crash);
     forward->pushString(string);
@@ -41,7 +41,7 @@ static void SV_DropClientHook(IRehldsHook_SV_DropClient *chain, IGameClient *cli
     PlayerMngr::m_playersNum--;
     plr->disconnect();
 
-    forward = gSPGlobal->getForwardManager()->getForward(ForwardMngr::FWD_PLAYER_DISCONNECTED);
+    forward = gSPGlobal->getForwardManager()->getForward(ForwardMngr::DefaultForward::PlayerDisconnected);
     forward->pushInt(plr->basePlayer()->edict()->getIndex());
     forward->pushInt(crash);
     forward->pushString(string);
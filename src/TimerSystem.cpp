@@ -18,13 +18,15 @@
  */
 
 #include <utility>
+#include <cmath>
 
 
 #include "spmod.hpp"
 
-Timer::Timer(float interval, Timer::Callback func, bool pause)
+Timer::Timer(float interval, Timer::Callback func, bool pause, std::uint32_t slot, TimerLateness *lateness)
     : m_interval(interval), m_callback(std::move(func)), m_paused(pause),
-      m_lastExec(gpGlobals->time)
+      m_lastExec(gpGlobals->time), m_slot(slot), m_lateness(lateness), m_group(nullptr), m_groupIndex(0),
+      m_executions(0), m_removed(false)
 {
     if (m_interval <= 0.0f)
         throw std::runtime_error("Interval lesser than or equal to 0");
@@ -43,6 +45,9 @@ void Timer::setInterval(float interval)
 {
     m_interval = interval;
     m_lastExec = gpGlobals->time;
+
+    if (!m_paused)
+        gSPGlobal->getTimerManager()->scheduleTimer(this);
 }
 
 void Timer::setPause(bool pause)
@@ -51,13 +56,29 @@ void Timer::setPause(bool pause)
 
     // Delay exec of timer by its interval
     if (!pause)
+    {
         m_lastExec = gpGlobals->time;
+        gSPGlobal->getTimerManager()->scheduleTimer(this);
+    }
+    else
+    {
+        gSPGlobal->getTimerManager()->unscheduleTimer(this);
+    }
 }
 
 bool Timer::exec()
 {
     m_lastExec = gpGlobals->time;
-    return m_callback(this);
+
+    // Callback may change interval or pause the timer, it will reschedule it then
+    if (!m_paused)
+        gSPGlobal->getTimerManager()->scheduleTimer(this);
+
+    m_executions++;
+    bool keep = m_callback(this);
+    m_executions--;
+
+    return keep && !m_removed;
 }
 
 float Timer::getLastExecTime() const
@@ -65,53 +86,388 @@ float Timer::getLastExecTime() const
     return m_lastExec;
 }
 
+std::uint32_t Timer::getSlot() const
+{
+    return m_slot;
+}
+
+TimerLateness *Timer::getLateness() const
+{
+    return m_lateness;
+}
+
+void Timer::setLateness(TimerLateness *lateness)
+{
+    m_lateness = lateness;
+}
+
+std::vector<ITimer *> *Timer::getGroup() const
+{
+    return m_group;
+}
+
+std::size_t Timer::getGroupIndex() const
+{
+    return m_groupIndex;
+}
+
+void Timer::setGroup(std::vector<ITimer *> *group, std::size_t index)
+{
+    m_group = group;
+    m_groupIndex = index;
+}
+
+bool Timer::isExecuting() const
+{
+    return m_executions;
+}
+
+void Timer::setRemoved()
+{
+    m_removed = true;
+}
+
 Timer *TimerMngr::createTimer(float interval, Timer::Callback func, bool pause)
 {
-    try
+    return createOwnedTimer(interval, func, pause, nullptr);
+}
+
+Timer *TimerMngr::createOwnedTimer(float interval,
+                                   Timer::Callback func,
+                                   bool pause,
+                                   IPlugin *owner,
+                                   std::uint32_t group)
+{
+    // Checked before anything is allocated, Timer constructor would throw
+    if (interval <= 0.0f)
+        return nullptr;
+
+    std::uint32_t slot;
+    if (!m_freeSlots.empty())
     {
-        return m_timers.emplace_back(std::make_unique<Timer>(interval, func, pause)).get();
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
     }
-    catch (const std::runtime_error &e [[maybe_unused]])
+    else
     {
-        return nullptr;
+        slot = static_cast<std::uint32_t>(m_slots.size());
+        m_slots.emplace_back();
     }
+
+    auto [lateness, added] = m_lateness.try_emplace(owner);
+    if (added)
+        lateness->second.name = owner ? owner->getIdentity() : "-";
+
+    Timer *timer =
+        (m_slots[slot].timer = std::make_unique<Timer>(interval, func, pause, slot, &lateness->second.lateness)).get();
+
+    Group &timers = m_groups[owner][group];
+    timer->setGroup(&timers, timers.size());
+    timers.push_back(timer);
+
+    if (!pause)
+        scheduleTimer(timer);
+
+    return timer;
+}
+
+void TimerMngr::scheduleTimer(const Timer *timer)
+{
+    Slot &slot = m_slots[timer->getSlot()];
+    float now = gpGlobals->time;
+
+    // Executions scheduled by timers being executed must not be due in the same pass
+    float execTime = std::max(now + timer->getInterval(), std::nextafter(now, std::numeric_limits<float>::max()));
+
+    m_queue.push_back({execTime, timer->getSlot(), ++slot.schedule});
+    std::push_heap(m_queue.begin(), m_queue.end(), std::greater<QueuedExec>());
+
+    _compactQueue();
+}
+
+void TimerMngr::unscheduleTimer(const Timer *timer)
+{
+    m_slots[timer->getSlot()].schedule++;
 }
 
 void TimerMngr::execTimers(float execTime)
 {
-    auto iter = m_timers.begin();
-    while (iter != m_timers.end())
-    {
-        Timer *task = (*iter).get();
+    bool limited = m_frameBudget != std::chrono::steady_clock::duration::zero();
+    auto start = limited ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+    bool executed = false;
 
-        if (task->isPaused() || task->getLastExecTime() + task->getInterval() > execTime)
+    while (!m_queue.empty() && m_queue.front().execTime <= execTime)
+    {
+        // Rest of due timers goes to the next frame, heap keeps them in order of execution time
+        if (limited && executed && std::chrono::steady_clock::now() - start >= m_frameBudget)
         {
-            ++iter;
-            continue;
+            m_deferredExecs += _countDue(execTime);
+            m_nextExecution = execTime;
+            break;
         }
 
-        if (!task->exec())
-            iter = m_timers.erase(iter);
-        else
-            ++iter;
+        std::pop_heap(m_queue.begin(), m_queue.end(), std::greater<QueuedExec>());
+        QueuedExec queued = m_queue.back();
+        m_queue.pop_back();
+
+        if (_isStale(queued))
+            continue;
+
+        Timer *task = m_slots[queued.slot].timer.get();
+        float delay = execTime - queued.execTime;
+        m_worstLateness = std::max(m_worstLateness, delay);
+        executed = true;
+
+        auto callbackStart = std::chrono::steady_clock::now();
+
+        bool keep = task->exec();
+
+        _addLateness(task->getLateness(), delay, std::chrono::steady_clock::now() - callbackStart);
+
+        if (!keep)
+            removeTimer(task);
     }
 }
 
 void TimerMngr::clearTimers()
 {
-    m_timers.clear();
+    m_slots.clear();
+    m_freeSlots.clear();
+    m_queue.clear();
+    m_groups.clear();
+    m_orphans.clear();
 }
 
 void TimerMngr::removeTimer(const ITimer *timer)
 {
-    auto iter = m_timers.begin();
-    while (iter != m_timers.end())
+    if (!timer)
+        return;
+
+    auto *task = static_cast<const Timer *>(timer);
+    if (task->getSlot() >= m_slots.size() || m_slots[task->getSlot()].timer.get() != task)
+        return;
+
+    // Callback is still running, whoever executed the timer removes it once exec() returns false
+    if (task->isExecuting())
+    {
+        m_slots[task->getSlot()].timer->setRemoved();
+        unscheduleTimer(task);
+        return;
+    }
+
+    // Last timer of the group takes place of the removed one
+    Group *group = task->getGroup();
+    auto *last = static_cast<Timer *>(group->back());
+    last->setGroup(group, task->getGroupIndex());
+    (*group)[task->getGroupIndex()] = last;
+    group->pop_back();
+
+    Slot &slot = m_slots[task->getSlot()];
+    m_freeSlots.push_back(task->getSlot());
+    slot.schedule++;
+    slot.timer.reset();
+}
+
+void TimerMngr::_compactQueue()
+{
+    if (m_queue.size() <= 2 * (m_slots.size() - m_freeSlots.size()) + 64)
+        return;
+
+    m_queue.erase(std::remove_if(m_queue.begin(), m_queue.end(),
+                                 [this](const QueuedExec &queued) { return _isStale(queued); }),
+                  m_queue.end());
+    std::make_heap(m_queue.begin(), m_queue.end(), std::greater<QueuedExec>());
+}
+
+std::size_t TimerMngr::_countDue(float execTime) const
+{
+    // Due executions form a subtree at the top of the heap
+    std::size_t count = 0;
+    std::stack<std::size_t> nodes;
+    nodes.push(0);
+
+    while (!nodes.empty())
     {
-        if ((*iter).get() == timer)
+        std::size_t node = nodes.top();
+        nodes.pop();
+
+        if (node >= m_queue.size() || m_queue[node].execTime > execTime)
+            continue;
+
+        if (!_isStale(m_queue[node]))
+            count++;
+
+        nodes.push(2 * node + 1);
+        nodes.push(2 * node + 2);
+    }
+
+    return count;
+}
+
+void TimerMngr::setFrameBudget(float budget)
+{
+    m_frameBudget = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<float, std::milli>(std::max(budget, 0.0f)));
+}
+
+float TimerMngr::getFrameBudget() const
+{
+    return std::chrono::duration<float, std::milli>(m_frameBudget).count();
+}
+
+std::uint64_t TimerMngr::getDeferredExecs() const
+{
+    return m_deferredExecs;
+}
+
+float TimerMngr::getWorstLateness() const
+{
+    return m_worstLateness;
+}
+
+void TimerMngr::resetBudgetStats()
+{
+    m_deferredExecs = 0;
+    m_worstLateness = 0.0f;
+}
+
+const TimerLateness *TimerMngr::getLateness(const IPlugin *owner) const
+{
+    auto iter = m_lateness.find(owner);
+    return iter != m_lateness.end() ? &iter->second.lateness : nullptr;
+}
+
+void TimerMngr::resetLateness()
+{
+    // Records are kept, timers point to them
+    for (auto &[owner, record] : m_lateness)
+        record.lateness = {};
+}
+
+void TimerMngr::_addLateness(TimerLateness *lateness, float delay, std::chrono::steady_clock::duration callbackTime)
+{
+    const auto &bounds = TimerLateness::BUCKET_BOUNDS;
+    auto bucket = std::upper_bound(bounds.begin(), bounds.end(), delay * 1000.0f) - bounds.begin();
+
+    lateness->buckets[bucket]++;
+    lateness->execs++;
+    lateness->totalDelay += delay;
+    lateness->worstDelay = std::max(lateness->worstDelay, delay);
+    lateness->callbacksTime += std::chrono::duration<double>(callbackTime).count();
+}
+
+void TimerMngr::dumpLateness(const Logger *logger) const
+{
+    static constexpr std::size_t nameWidth = 20;
+    static constexpr std::size_t numWidth = 10;
+
+    std::ostringstream header;
+    header << std::left << std::setw(nameWidth) << "owner" << std::right << std::setw(numWidth) << "execs"
+           << std::setw(numWidth) << "avg ms" << std::setw(numWidth) << "worst ms" << std::setw(numWidth) << "cb ms";
+
+    for (float bound : TimerLateness::BUCKET_BOUNDS)
+        header << std::setw(numWidth) << "<" + std::to_string(static_cast<int>(bound));
+    header << std::setw(numWidth) << ">=" + std::to_string(static_cast<int>(TimerLateness::BUCKET_BOUNDS.back()));
+
+    logger->sendMsgToConsoleInternal("\nDelays of timer executions by owner");
+    logger->sendMsgToConsoleInternal(header.str());
+
+    for (const auto &[owner, record] : m_lateness)
+    {
+        const TimerLateness &lateness = record.lateness;
+        if (!lateness.execs)
+            continue;
+
+        std::ostringstream row;
+        row << std::left << std::setw(nameWidth) << std::string_view(record.name).substr(0, nameWidth - 1)
+            << std::right << std::fixed << std::setprecision(2) << std::setw(numWidth) << lateness.execs
+            << std::setw(numWidth) << lateness.totalDelay * 1000.0 / lateness.execs << std::setw(numWidth)
+            << lateness.worstDelay * 1000.0f << std::setw(numWidth) << lateness.callbacksTime * 1000.0;
+
+        for (std::uint64_t count : lateness.buckets)
+            row << std::setw(numWidth) << count;
+
+        logger->sendMsgToConsoleInternal(row.str());
+    }
+}
+
+TimerMngr::Group *TimerMngr::_findGroup(const IPlugin *owner, std::uint32_t group) const
+{
+    auto ownerIter = m_groups.find(owner);
+    if (ownerIter == m_groups.end())
+        return nullptr;
+
+    auto groupIter = ownerIter->second.find(group);
+    if (groupIter == ownerIter->second.end())
+        return nullptr;
+
+    return const_cast<Group *>(&groupIter->second);
+}
+
+const std::vector<ITimer *> &TimerMngr::getGroupTimers(const IPlugin *owner, std::uint32_t group) const
+{
+    static const Group empty;
+
+    const Group *timers = _findGroup(owner, group);
+    return timers ? *timers : empty;
+}
+
+void TimerMngr::pauseGroup(const IPlugin *owner, std::uint32_t group)
+{
+    if (Group *timers = _findGroup(owner, group); timers)
+    {
+        for (ITimer *timer : *timers)
         {
-            m_timers.erase(iter);
-            break;
+            if (!timer->isPaused())
+                timer->setPause(true);
         }
-        ++iter;
     }
-}
\ No newline at end of file
+}
+
+void TimerMngr::resumeGroup(const IPlugin *owner, std::uint32_t group)
+{
+    if (Group *timers = _findGroup(owner, group); timers)
+    {
+        for (ITimer *timer : *timers)
+        {
+            if (timer->isPaused())
+                timer->setPause(false);
+        }
+    }
+}
+
+void TimerMngr::cancelGroup(const IPlugin *owner, std::uint32_t group)
+{
+    Group *timers = _findGroup(owner, group);
+    if (!timers)
+        return;
+
+    // Removing reorders the group, timer being executed stays in it until its callback returns
+    Group toRemove(*timers);
+    for (ITimer *timer : toRemove)
+        removeTimer(timer);
+}
+
+void TimerMngr::cancelOwnerTimers(const IPlugin *owner)
+{
+    if (auto ownerIter = m_groups.find(owner); ownerIter != m_groups.end())
+    {
+        for (auto &[id, timers] : ownerIter->second)
+        {
+            cancelGroup(owner, id);
+
+            // Only timers being executed are left, they are removed once their callbacks return
+            for (ITimer *timer : timers)
+            {
+                auto *task = static_cast<Timer *>(timer);
+                task->setGroup(&m_orphans, m_orphans.size());
+                task->setLateness(&m_orphansLateness);
+                m_orphans.push_back(task);
+            }
+        }
+        m_groups.erase(ownerIter);
+    }
+
+    // Another plugin may get the same address, it must not inherit the delays
+    m_lateness.erase(owner);
+}
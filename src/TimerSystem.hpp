@@ -29,7 +29,7 @@ public:
     Timer(Timer &&other) = default;
     ~Timer() = default;
 
-    Timer(float interval, Callback func, bool pause);
+    Timer(float interval, Callback func, bool pause, std::uint32_t slot, TimerLateness *lateness);
 
     // ITimer
     float getInterval() const override;
@@ -40,6 +40,14 @@ public:
 
     // Timer
     float getLastExecTime() const;
+    std::uint32_t getSlot() const;
+    TimerLateness *getLateness() const;
+    void setLateness(TimerLateness *lateness);
+    std::vector<ITimer *> *getGroup() const;
+    std::size_t getGroupIndex() const;
+    void setGroup(std::vector<ITimer *> *group, std::size_t index);
+    bool isExecuting() const;
+    void setRemoved();
 
 private:
     /* interval */
@@ -53,6 +61,20 @@ private:
 
     /* last execution */
     float m_lastExec;
+
+    /* slot in timer manager */
+    std::uint32_t m_slot;
+
+    /* delays of the owner */
+    TimerLateness *m_lateness;
+
+    /* group in timer manager and position in it */
+    std::vector<ITimer *> *m_group;
+    std::size_t m_groupIndex;
+
+    /* nested executions of callback, removing timer is delayed until the outermost returns */
+    std::uint32_t m_executions;
+    bool m_removed;
 };
 
 class TimerMngr final : public ITimerMngr
@@ -61,17 +83,103 @@ public:
     TimerMngr() = default;
     ~TimerMngr() = default;
 
-    Timer *createTimer(float interval,
-                       Timer::Callback callback,
-                       bool pause = false) override;
+    Timer *createTimer(float interval, Timer::Callback callback, bool pause = false) override;
     void removeTimer(const ITimer *timer) override;
+    void setFrameBudget(float budget) override;
+    float getFrameBudget() const override;
+    std::uint64_t getDeferredExecs() const override;
+    float getWorstLateness() const override;
+    void resetBudgetStats() override;
+    const TimerLateness *getLateness(const IPlugin *owner) const override;
+    void resetLateness() override;
+    const std::vector<ITimer *> &getGroupTimers(const IPlugin *owner, std::uint32_t group) const override;
+    void pauseGroup(const IPlugin *owner, std::uint32_t group) override;
+    void resumeGroup(const IPlugin *owner, std::uint32_t group) override;
+    void cancelGroup(const IPlugin *owner, std::uint32_t group) override;
+    void cancelOwnerTimers(const IPlugin *owner) override;
+    Timer *createOwnedTimer(float interval,
+                            Timer::Callback callback,
+                            bool pause,
+                            IPlugin *owner,
+                            std::uint32_t group = 0) override;
 
     void execTimers(float execTime);
     void clearTimers();
+    void dumpLateness(const Logger *logger) const;
+
+    /* Queues timer to be executed after its interval from now, replaces previous queued execution */
+    void scheduleTimer(const Timer *timer);
+
+    /* Drops queued execution of timer */
+    void unscheduleTimer(const Timer *timer);
 
     /* next execution of timers */
     static inline float m_nextExecution;
 
 private:
-    std::vector<std::unique_ptr<Timer>> m_timers;
+    struct Slot
+    {
+        std::unique_ptr<Timer> timer;
+
+        /* Bumped on every (un)scheduling, queued executions with older value are stale */
+        std::uint32_t schedule = 0;
+    };
+
+    struct QueuedExec
+    {
+        float execTime;
+        std::uint32_t slot;
+        std::uint32_t schedule;
+
+        bool operator>(const QueuedExec &other) const
+        {
+            return execTime > other.execTime;
+        }
+    };
+
+    bool _isStale(const QueuedExec &queued) const
+    {
+        return m_slots[queued.slot].schedule != queued.schedule;
+    }
+
+    /* Drops stale executions once they outnumber the timers */
+    void _compactQueue();
+
+    /* Counts executions which are due but left in the queue */
+    std::size_t _countDue(float execTime) const;
+
+    static void _addLateness(TimerLateness *lateness, float delay, std::chrono::steady_clock::duration callbackTime);
+
+    /* Timers are never moved, slots are reused after removal */
+    std::vector<Slot> m_slots;
+    std::vector<std::uint32_t> m_freeSlots;
+
+    /* Min heap of queued executions, removing or rescheduling timer leaves stale one behind */
+    std::vector<QueuedExec> m_queue;
+
+    /* Time limit of a single execTimers pass, zero if there is none */
+    std::chrono::steady_clock::duration m_frameBudget = std::chrono::steady_clock::duration::zero();
+    std::uint64_t m_deferredExecs = 0;
+    float m_worstLateness = 0.0f;
+
+    struct OwnerLateness
+    {
+        /* Owner might be gone by the time delays are displayed */
+        std::string name;
+        TimerLateness lateness;
+    };
+
+    /* Delays by owner, nodes are stable so timers keep pointers to them, dropped with timers of the owner */
+    std::unordered_map<const IPlugin *, OwnerLateness> m_lateness;
+
+    using Group = std::vector<ITimer *>;
+
+    /* Timers by owner and group, groups are kept until timers of the owner are cancelled */
+    std::unordered_map<const IPlugin *, std::unordered_map<std::uint32_t, Group>> m_groups;
+
+    /* Removed timers whose callbacks are still running after records of their owners are dropped */
+    Group m_orphans;
+    TimerLateness m_orphansLateness = {};
+
+    Group *_findGroup(const IPlugin *owner, std::uint32_t group) const;
 };
@@ -54,28 +54,104 @@ std::string Utils::strReplaced(std::string_view source, std::string_view from, s
 
 void Utils::ShowMenu(const Engine::Edict *pEdict, std::uint32_t slots, std::uint32_t time, std::string_view menu)
 {
-    static constexpr std::size_t maxStringToSend = 175;
-    static constexpr std::size_t maxMenuLength = 512;
-
     if (!gmsgShowMenu)
         return; // some games don't support ShowMenu (Firearms)
 
-    std::size_t currentPos = 0;
-    std::size_t menuLength = (menu.length() > maxMenuLength) ? maxMenuLength : menu.length();
-    std::string_view buffer = (menuLength > maxStringToSend) ? menu.substr(0, maxStringToSend) : menu;
+    EncodedMenu encoded;
+    _encodeMenu(menu, encoded);
+    _writeMenu(*pEdict, slots, time, encoded);
+}
+
+void Utils::showMenu(std::uint32_t players, std::uint32_t slots, std::uint32_t time, std::string_view menu) const
+{
+    if (!gmsgShowMenu)
+        return;
+
+    players = _filterRecipients(players);
+    if (!players)
+        return;
+
+    EncodedMenu encoded;
+    _encodeMenu(menu, encoded);
+
+    PlayerMngr *plrMngr = gSPGlobal->getPlayerManager();
+    for (std::uint32_t i = 1; i <= MAX_PLAYERS; i++)
+    {
+        if (players & (1U << (i - 1)))
+            _writeMenu(*plrMngr->getPlayer(i)->edict(), slots, time, encoded);
+    }
+}
+
+void Utils::showMenu(const std::uint32_t *players,
+                     std::size_t count,
+                     std::uint32_t slots,
+                     std::uint32_t time,
+                     std::string_view menu) const
+{
+    showMenu(_toPlayersMask(players, count), slots, time, menu);
+}
+
+void Utils::_encodeMenu(std::string_view menu, EncodedMenu &encoded)
+{
+    menu = menu.substr(0, MAX_MENU_LENGTH);
+    encoded.count = 0;
+
+    // Empty menu is still sent once, it closes the current one
     do
     {
-        menuLength -= buffer.length();
-        MESSAGE_BEGIN(MSG_ONE, gmsgShowMenu, nullptr, *pEdict);
+        std::string_view chunk = menu.substr(0, MAX_MENU_CHUNK_LENGTH);
+        char *buffer = encoded.chunks[encoded.count++];
+
+        std::memcpy(buffer, chunk.data(), chunk.length());
+        buffer[chunk.length()] = '\0';
+
+        menu.remove_prefix(chunk.length());
+    } while (!menu.empty());
+}
+
+void Utils::_writeMenu(edict_t *edict, std::uint32_t slots, std::uint32_t time, const EncodedMenu &encoded)
+{
+    for (std::size_t i = 0; i < encoded.count; i++)
+    {
+        MESSAGE_BEGIN(MSG_ONE, gmsgShowMenu, nullptr, edict);
         WRITE_SHORT(slots);
         WRITE_CHAR(time);
-        WRITE_BYTE((menuLength > 0) ? true : false);
-        WRITE_STRING(buffer.data());
+        WRITE_BYTE((i + 1 < encoded.count) ? true : false);
+        WRITE_STRING(encoded.chunks[i]);
         MESSAGE_END();
+    }
+}
+
+std::uint32_t Utils::_toPlayersMask(const std::uint32_t *players, std::size_t count)
+{
+    std::uint32_t mask = 0;
 
-        currentPos += buffer.length();
-        buffer = menu.substr(currentPos, (menuLength > maxStringToSend) ? maxStringToSend : std::string_view::npos);
-    } while (menuLength > 0);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        if (players[i] >= 1 && players[i] <= MAX_PLAYERS)
+            mask |= 1U << (players[i] - 1);
+    }
+
+    return mask;
+}
+
+std::uint32_t Utils::_filterRecipients(std::uint32_t players)
+{
+    PlayerMngr *plrMngr = gSPGlobal->getPlayerManager();
+    std::uint32_t maxClients = plrMngr->getMaxClients();
+
+    for (std::uint32_t i = 1; i <= MAX_PLAYERS; i++)
+    {
+        std::uint32_t bit = 1U << (i - 1);
+        if (!(players & bit))
+            continue;
+
+        Player *player = (i <= maxClients) ? plrMngr->getPlayer(i) : nullptr;
+        if (!player || !player->isInGame() || player->isFake())
+            players &= ~bit;
+    }
+
+    return players;
 }
 
 void Utils::trimMultiByteChar(std::string &str)
@@ -138,23 +214,69 @@ void Utils::trimMultiByteChar(std::string &str)
 
 void Utils::sendTextMsg(std::string_view message, TextMsgDest msgDest, Engine::Edict *edict)
 {
-    static std::uint8_t msgTextMsgId = GET_USER_MSG_ID(PLID, "TextMsg", nullptr);
-    if (!msgTextMsgId)
+    if (!_getTextMsgId())
         return;				// :TODO: Maybe output a warning log?
 
-    constexpr std::size_t maxLength = 187;
+    EncodedTextMsg encoded;
+    _encodeTextMsg(message, encoded);
+    _writeTextMsg(edict ? static_cast<edict_t *>(*edict) : nullptr, msgDest, encoded);
+}
+
+void Utils::sendTextMsg(std::uint32_t players, TextMsgDest msgDest, std::string_view message) const
+{
+    if (!_getTextMsgId())
+        return;
+
+    players = _filterRecipients(players);
+    if (!players)
+        return;
+
+    EncodedTextMsg encoded;
+    _encodeTextMsg(message, encoded);
+
+    PlayerMngr *plrMngr = gSPGlobal->getPlayerManager();
+    for (std::uint32_t i = 1; i <= MAX_PLAYERS; i++)
+    {
+        if (players & (1U << (i - 1)))
+            _writeTextMsg(*plrMngr->getPlayer(i)->edict(), msgDest, encoded);
+    }
+}
+
+void Utils::sendTextMsg(const std::uint32_t *players,
+                        std::size_t count,
+                        TextMsgDest msgDest,
+                        std::string_view message) const
+{
+    sendTextMsg(_toPlayersMask(players, count), msgDest, message);
+}
+
+std::uint8_t Utils::_getTextMsgId()
+{
+    static std::uint8_t msgTextMsgId = GET_USER_MSG_ID(PLID, "TextMsg", nullptr);
+    return msgTextMsgId;
+}
+
+void Utils::_encodeTextMsg(std::string_view message, EncodedTextMsg &encoded)
+{
+    message = message.substr(0, MAX_TEXTMSG_LENGTH);
 
+    std::memcpy(encoded.message, message.data(), message.length());
+    encoded.message[message.length()] = '\0';
+}
+
+void Utils::_writeTextMsg(edict_t *edict, TextMsgDest msgDest, const EncodedTextMsg &encoded)
+{
     if (edict)
     {
-        MESSAGE_BEGIN(MSG_ONE, msgTextMsgId, nullptr, *edict);
+        MESSAGE_BEGIN(MSG_ONE, _getTextMsgId(), nullptr, edict);
     }
     else
     {
-        MESSAGE_BEGIN(MSG_BROADCAST, msgTextMsgId);
+        MESSAGE_BEGIN(MSG_BROADCAST, _getTextMsgId());
     }
 
     WRITE_BYTE(static_cast<std::uint8_t>(msgDest));	// 1 byte
     WRITE_STRING("%s");	// 3 bytes (2 + EOS)
-    WRITE_STRING(message.substr(0, maxLength).data());	// max 188 bytes (187 + EOS)
+    WRITE_STRING(encoded.message);	// max 188 bytes (187 + EOS)
     MESSAGE_END();		// max 192 bytes
-}
\ No newline at end of file
+}
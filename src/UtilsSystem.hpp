@@ -28,7 +28,49 @@ public:
     std::size_t strCopy(char *buffer, std::size_t size, std::string_view src) const override;
     std::string strReplaced(std::string_view source, std::string_view from, std::string_view to) const override;
 
+    void sendTextMsg(std::uint32_t players, TextMsgDest msgDest, std::string_view message) const override;
+    void sendTextMsg(const std::uint32_t *players,
+                     std::size_t count,
+                     TextMsgDest msgDest,
+                     std::string_view message) const override;
+    void showMenu(std::uint32_t players, std::uint32_t slots, std::uint32_t time, std::string_view menu) const override;
+    void showMenu(const std::uint32_t *players,
+                  std::size_t count,
+                  std::uint32_t slots,
+                  std::uint32_t time,
+                  std::string_view menu) const override;
+
     static void ShowMenu(const Engine::Edict *pEdict, std::uint32_t slots, std::uint32_t time, std::string_view menu);
     static void trimMultiByteChar(std::string &str);
     static void sendTextMsg(std::string_view message, TextMsgDest msgDest, Engine::Edict *edict = nullptr);
+
+private:
+    static constexpr std::size_t MAX_TEXTMSG_LENGTH = 187;
+    static constexpr std::size_t MAX_MENU_CHUNK_LENGTH = 175;
+    static constexpr std::size_t MAX_MENU_LENGTH = 512;
+    static constexpr std::size_t MAX_MENU_CHUNKS = (MAX_MENU_LENGTH + MAX_MENU_CHUNK_LENGTH - 1) / MAX_MENU_CHUNK_LENGTH;
+
+    /* Payloads are encoded once and replayed for every recipient */
+    struct EncodedTextMsg
+    {
+        char message[MAX_TEXTMSG_LENGTH + 1];
+    };
+
+    struct EncodedMenu
+    {
+        char chunks[MAX_MENU_CHUNKS][MAX_MENU_CHUNK_LENGTH + 1];
+        std::size_t count;
+    };
+
+    static std::uint8_t _getTextMsgId();
+    static std::uint32_t _toPlayersMask(const std::uint32_t *players, std::size_t count);
+
+    static void _encodeTextMsg(std::string_view message, EncodedTextMsg &encoded);
+    static void _writeTextMsg(edict_t *edict, TextMsgDest msgDest, const EncodedTextMsg &encoded);
+
+    static void _encodeMenu(std::string_view menu, EncodedMenu &encoded);
+    static void _writeMenu(edict_t *edict, std::uint32_t slots, std::uint32_t time, const EncodedMenu &encoded);
+
+    /* Drops players who are not in game and bots from recipients */
+    static std::uint32_t _filterRecipients(std::uint32_t players);
 };
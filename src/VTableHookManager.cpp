@@ -75,149 +75,229 @@ namespace
 
 namespace
 {
-    std::uint32_t instanceToId(void *instance)
+    entvars_t *instanceToPev(void *instance)
     {
         static std::uint32_t offset = gSPGlobal->getVTableManager()->getPevOffset();
-        return ENTINDEX(ENT(*reinterpret_cast<entvars_t **>(reinterpret_cast<std::intptr_t *>(instance) + offset)));
+        return *reinterpret_cast<entvars_t **>(reinterpret_cast<std::intptr_t *>(instance) + offset);
     }
-    /* virtual void	Spawn( void ) { return; } */
-    void vSpawnHook(
-#if defined SP_POSIX
-        void *instance
-#endif
-    )
+
+    /*
+     * Conversions between native params of hooked functions and params passed to callbacks.
+     * CBaseEntity pointers are passed as void *, callbacks get their edicts.
+     */
+    template<typename T>
+    struct VParam;
+
+    template<>
+    struct VParam<std::int32_t>
     {
-#if defined SP_WINDOWS
-        void *instance;
-        __asm
+        static VTableHook::Param pack(VTableHook *hook [[maybe_unused]], std::int32_t &value)
         {
-            mov [instance], ecx
+            return value;
         }
-#endif
-        VTableHook *hook = gSPGlobal->getVTableManager()->getHook(VTableHookManager::vFuncType::Spawn);
-        hook->prepareForCall();
-        hook->packParams(instanceToId(instance));
+        static std::int32_t unpack(const VTableHook::Param &param)
+        {
+            return std::get<std::int32_t>(param);
+        }
+    };
+
+    template<>
+    struct VParam<float>
+    {
+        static VTableHook::Param pack(VTableHook *hook [[maybe_unused]], float &value)
+        {
+            return value;
+        }
+        static float unpack(const VTableHook::Param &param)
+        {
+            return std::get<float>(param);
+        }
+    };
 
-        VTableHook::Return retValve = hook->execCallbacks();
+    template<>
+    struct VParam<entvars_t *>
+    {
+        static VTableHook::Param pack(VTableHook *hook [[maybe_unused]], entvars_t *&value)
+        {
+            return static_cast<Engine::IEntVars *>(value ? gSPGlobal->getEngine()->getEntVars(value) : nullptr);
+        }
+        static entvars_t *unpack(const VTableHook::Param &param)
+        {
+            auto *entVars = static_cast<Engine::EntVars *>(std::get<Engine::IEntVars *>(param));
+            return entVars ? static_cast<entvars_t *>(*entVars) : nullptr;
+        }
+    };
+
+    template<>
+    struct VParam<void *>
+    {
+        static VTableHook::Param pack(VTableHook *hook [[maybe_unused]], void *&value)
+        {
+            if (!value)
+                return static_cast<Engine::IEdict *>(nullptr);
+
+            return static_cast<Engine::IEdict *>(gSPGlobal->getEngine()->getEdict(ENT(instanceToPev(value))));
+        }
+        static void *unpack(const VTableHook::Param &param)
+        {
+            auto *edict = static_cast<Engine::Edict *>(std::get<Engine::IEdict *>(param));
+            return edict ? static_cast<edict_t *>(*edict)->pvPrivateData : nullptr;
+        }
+    };
+
+    template<>
+    struct VParam<Vector>
+    {
+        // Points to the param of the trampoline, valid for the whole call
+        static VTableHook::Param pack(VTableHook *hook [[maybe_unused]], Vector &value)
+        {
+            return &value.x;
+        }
+        static Vector unpack(const VTableHook::Param &param)
+        {
+            return Vector(std::get<float *>(param));
+        }
+    };
 
-        if (retValve != VTableHook::Return::Supercede)
+    template<>
+    struct VParam<::TraceResult *>
+    {
+        static VTableHook::Param pack(VTableHook *hook, ::TraceResult *&value)
         {
-            hook->execOriginalFunc<>(instance);
+            return static_cast<Engine::ITraceResult *>(hook->wrapTraceResult(value));
         }
+        static ::TraceResult *unpack(const VTableHook::Param &param)
+        {
+            return *static_cast<Engine::TraceResult *>(std::get<Engine::ITraceResult *>(param));
+        }
+    };
+
+    template<typename Ret, typename... Args, std::size_t... I>
+    Ret execOriginalWithParams(VTableHook *hook, void *instance, std::index_sequence<I...>)
+    {
+        const auto &params = hook->getParams();
 
-        hook->execCallbacks(true);
-        hook->cleanup();
+        // The first param is the index of the instance
+        return hook->execOriginalFunc<Ret, Args...>(instance, VParam<Args>::unpack(params[I + 1])...);
     }
 
-    /*int TakeDamage( entvars_t* pevInflictor, entvars_t* pevAttacker, float flDamage, int bitsDamageType); */
-    std::int32_t vTakeDamageHook(
+    /*
+     * Trampoline of a hooked virtual function.
+     * Func is the index of the function in gamedata, one instance exists for every index and signature.
+     */
+    template<std::size_t Func, typename Ret, typename... Args>
 #if defined SP_POSIX
-        void *instance,
+    Ret vHook(void *instance, Args... args)
+#else
+    Ret __fastcall vHook(void *instance, int, Args... args)
 #endif
-        entvars_t *pevInflictor,
-        entvars_t *pevAttacker,
-        float flDamage,
-        std::int32_t bitsDamageType [[maybe_unused]])
     {
-#if defined SP_WINDOWS
-        void *instance;
-        __asm
+        VTableHook *hook = gSPGlobal->getVTableManager()->getHook(instance, Func);
+        entvars_t *pev = instanceToPev(instance);
+        std::uint32_t id = ENTINDEX(ENT(pev));
+
+        // Entities nobody is interested in skip callbacks and params packing
+        if (!hook->passesFilter(id, pev))
         {
-            mov [instance], ecx
+            return hook->callOriginalFunc<Ret, Args...>(instance, args...);
         }
-#endif
-        VTableHook *hook = gSPGlobal->getVTableManager()->getHook(VTableHookManager::vFuncType::TakeDamage);
+
         hook->prepareForCall();
-        hook->packParams(instanceToId(instance), gSPGlobal->getEngine()->getEntVars(pevInflictor),
-                         gSPGlobal->getEngine()->getEntVars(pevAttacker), flDamage, bitsDamageType);
+        hook->packParams(id, VParam<Args>::pack(hook, args)...);
 
         VTableHook::Return status = hook->execCallbacks();
         if (status == VTableHook::Return::Ignored)
         {
-            hook->execOriginalFunc<std::int32_t, entvars_t *, entvars_t *, float, std::int32_t>(
-                instance, pevInflictor, pevAttacker, flDamage, bitsDamageType);
+            hook->execOriginalFunc<Ret, Args...>(instance, args...);
         }
         else if (status >= VTableHook::Return::Handled && status <= VTableHook::Return::Override)
         {
-            const auto &params = hook->getParams();
-            hook->execOriginalFunc<std::int32_t, entvars_t *, entvars_t *, float, std::int32_t>(
-                instance, *static_cast<Engine::EntVars *>(std::get<Engine::IEntVars *>(params[1])),
-                *static_cast<Engine::EntVars *>(std::get<Engine::IEntVars *>(params[2])), std::get<float>(params[3]),
-                std::get<std::int32_t>(params[4]));
+            execOriginalWithParams<Ret, Args...>(hook, instance, std::index_sequence_for<Args...>());
         }
 
         status = hook->execCallbacks(true);
 
-        if (status >= VTableHook::Return::Override && hook->getReturn())
+        if constexpr (std::is_same_v<Ret, void>)
         {
-            auto retVal = std::get<std::int32_t>(*hook->getReturn());
             hook->cleanup();
-            return retVal;
         }
-
-        if (hook->getOriginalReturn())
+        else
         {
-            auto retVal = std::get<std::int32_t>(*hook->getOriginalReturn());
+            // Supercede might have been returned without return value set
+            Ret retVal = 0;
+
+            if (status >= VTableHook::Return::Override && hook->getReturn())
+            {
+                retVal = std::get<Ret>(*hook->getReturn());
+            }
+            else if (hook->getOriginalReturn())
+            {
+                retVal = std::get<Ret>(*hook->getOriginalReturn());
+            }
+
             hook->cleanup();
             return retVal;
         }
+    }
 
-        // Supercede was returned without return value set
-        return 0;
+    using TrampolineTable = std::array<std::intptr_t, VTableHookManager::MAX_FUNCS>;
+
+    template<typename Ret, typename... Args, std::size_t... Funcs>
+    TrampolineTable makeTrampolines(std::index_sequence<Funcs...>)
+    {
+        return {{reinterpret_cast<std::intptr_t>(&vHook<Funcs, Ret, Args...>)...}};
     }
 
-    /*void TraceAttack( entvars_t *pevAttacker, float flDamage, Vector vecDir, TraceResult *ptr, int
-     * bitsDamageType); */
-    void vTraceAttack(
-#if defined SP_POSIX
-        void *instance,
-#endif
-        entvars_t *pevAttacker,
-        float flDamage,
-        Vector vecDir,
-        ::TraceResult *ptr,
-        std::int32_t bitsDamageType)
+    template<typename Ret, typename... Args>
+    const TrampolineTable &getTrampolines()
     {
-#if defined SP_WINDOWS
-        void *instance;
-        __asm
-        {
-            mov [instance], ecx
-        }
-#endif
-        VTableHook *hook = gSPGlobal->getVTableManager()->getHook(VTableHookManager::vFuncType::TraceAttack);
-        hook->prepareForCall();
-        Engine::TraceResult *tr = gSPGlobal->getEngine()->createTraceResult(ptr);
-        hook->packParams(instanceToId(instance), gSPGlobal->getEngine()->getEntVars(pevAttacker), flDamage, &vecDir.x,
-                         tr, bitsDamageType);
+        static const TrampolineTable trampolines =
+            makeTrampolines<Ret, Args...>(std::make_index_sequence<VTableHookManager::MAX_FUNCS>());
+        return trampolines;
+    }
 
-        VTableHook::Return status = hook->execCallbacks();
-        if (status == VTableHook::Return::Ignored)
-        {
-            hook->execOriginalFunc<void, entvars_t *, float, Vector, ::TraceResult *, std::int32_t>(
-                instance, pevAttacker, flDamage, vecDir, ptr, bitsDamageType);
-        }
-        else if (status >= VTableHook::Return::Handled && status <= VTableHook::Return::Override)
+    /*
+     * Signatures which can be used in gamedata.
+     * cbase is CBaseEntity pointer, entvars is entvars_t pointer, trace is TraceResult pointer.
+     */
+    constexpr std::pair<std::string_view, const TrampolineTable &(*)()> gSignatures[] = {
+        {"void()", &getTrampolines<void>},
+        {"int()", &getTrampolines<std::int32_t>},
+        {"void(cbase)", &getTrampolines<void, void *>},
+        {"int(cbase)", &getTrampolines<std::int32_t, void *>},
+        {"void(entvars)", &getTrampolines<void, entvars_t *>},
+        {"void(entvars,int)", &getTrampolines<void, entvars_t *, std::int32_t>},
+        {"void(cbase,cbase,int,float)", &getTrampolines<void, void *, void *, std::int32_t, float>},
+        {"int(float,int)", &getTrampolines<std::int32_t, float, std::int32_t>},
+        {"int(entvars,entvars,float,int)",
+         &getTrampolines<std::int32_t, entvars_t *, entvars_t *, float, std::int32_t>},
+        {"void(entvars,float,vector,trace,int)",
+         &getTrampolines<void, entvars_t *, float, Vector, ::TraceResult *, std::int32_t>}};
+
+    /* Functions hookable through vFuncType, signatures are known even if gamedata does not have them */
+    constexpr std::pair<std::string_view, std::string_view> gBuiltinFuncs[] = {
+        {"spawn", "void()"},
+        {"takedamage", "int(entvars,entvars,float,int)"},
+        {"traceattack", "void(entvars,float,vector,trace,int)"}};
+
+    const TrampolineTable *findTrampolines(std::string_view signature)
+    {
+        for (const auto &[name, getter] : gSignatures)
         {
-            const auto &params = hook->getParams();
-
-            hook->execOriginalFunc<void, entvars_t *, float, Vector, ::TraceResult *, std::int32_t>(
-                instance, *static_cast<Engine::EntVars *>(std::get<Engine::IEntVars *>(params[1])), std::get<float>(params[2]),
-                Vector(std::get<float *>(params[3])), *tr, std::get<std::int32_t>(params[5]));
+            if (name == signature)
+                return &getter();
         }
 
-        hook->execCallbacks(true);
-        gSPGlobal->getEngine()->freeTraceResult(tr);
-        hook->cleanup();
+        return nullptr;
     }
-
 } // namespace
 
 VTableHook::VTableHook(std::intptr_t vtable,
                        std::intptr_t entry,
                        std::intptr_t hook,
                        const std::vector<Callback> &callbacks)
-    : m_vtable(vtable), m_entry(entry), m_callbacks(callbacks)
+    : m_vtable(vtable), m_entry(entry), m_callbacks(callbacks), m_passAll(false), m_filterPlayers(false),
+      m_frames(MAX_CALL_DEPTH), m_depth(0)
 {
     m_original = *(reinterpret_cast<std::intptr_t *>(m_entry));
 
@@ -247,11 +327,45 @@ VTableHook::Return VTableHook::execCallbacks(bool post)
     return returnVal;
 }
 
+void VTableHook::addFilter(const VTableHookFilter *filter)
+{
+    if (m_passAll)
+    {
+        return;
+    }
+
+    if (!filter || filter->isEmpty())
+    {
+        m_passAll = true;
+        m_filterPlayers = false;
+        m_filterIndexes.reset();
+        m_filterClassnames.clear();
+        return;
+    }
+
+    m_filterPlayers |= filter->playersOnly;
+    m_filterIndexes |= filter->indexes;
+
+    for (const auto &classname : filter->classnames)
+    {
+        if (std::find(m_filterClassnames.begin(), m_filterClassnames.end(), classname) == m_filterClassnames.end())
+        {
+            m_filterClassnames.emplace_back(classname);
+        }
+    }
+}
+
+bool VTableHook::_matchesClassname(const entvars_t *pev) const
+{
+    std::string_view classname(STRING(pev->classname));
+    return std::find(m_filterClassnames.begin(), m_filterClassnames.end(), classname) != m_filterClassnames.end();
+}
+
 const std::optional<VTableHook::Param> &VTableHook::getReturn() const
 {
-    if (m_return.size())
+    if (m_depth)
     {
-        return m_return.top();
+        return m_frames[m_depth - 1].returnValue;
     }
 
     static std::optional<Param> empty;
@@ -260,9 +374,9 @@ const std::optional<VTableHook::Param> &VTableHook::getReturn() const
 
 const std::optional<VTableHook::Param> &VTableHook::getOriginalReturn() const
 {
-    if (m_originalReturn.size())
+    if (m_depth)
     {
-        return m_originalReturn.top();
+        return m_frames[m_depth - 1].originalReturn;
     }
 
     static std::optional<Param> empty;
@@ -271,9 +385,9 @@ const std::optional<VTableHook::Param> &VTableHook::getOriginalReturn() const
 
 std::vector<VTableHook::Param> &VTableHook::getParams()
 {
-    if (m_params.size())
+    if (m_depth)
     {
-        return m_params.top();
+        return _getFrame().params;
     }
 
     static std::vector<Param> empty;
@@ -282,9 +396,9 @@ std::vector<VTableHook::Param> &VTableHook::getParams()
 
 void VTableHook::setReturn(Param retVal)
 {
-    if (m_return.size())
+    if (m_depth)
     {
-        m_return.top() = retVal;
+        _getFrame().returnValue = retVal;
     }
 }
 
@@ -298,7 +412,7 @@ std::intptr_t VTableHook::getVTable() const
     return m_vtable;
 }
 
-VTableHookManager::VTableHookManager(const fs::path &configsDir, ModType modType)
+VTableHookManager::VTableHookManager(const fs::path &configsDir, ModType modType) : m_funcs(), m_funcsNum(0)
 {
     try
     {
@@ -318,6 +432,36 @@ VTableHookManager::VTableHookManager(const fs::path &configsDir, ModType modType
                 m_vTableOffsets.try_emplace(funcIt->first.as<std::string>(),
                                             funcIt->second[osName.data()].as<std::uint32_t>());
             }
+
+            // Functions with known signature get their own trampolines
+            for (auto funcIt = rootNode.begin(); funcIt != rootNode.end(); ++funcIt)
+            {
+                std::string name = funcIt->first.as<std::string>();
+                std::string signature;
+
+                if (funcIt->second["signature"])
+                {
+                    signature = funcIt->second["signature"].as<std::string>();
+                    signature.erase(std::remove(signature.begin(), signature.end(), ' '), signature.end());
+                }
+                else
+                {
+                    for (const auto &[builtinName, builtinSignature] : gBuiltinFuncs)
+                    {
+                        if (builtinName == name)
+                            signature = builtinSignature;
+                    }
+                }
+
+                const TrampolineTable *trampolines = signature.empty() ? nullptr : findTrampolines(signature);
+                if (!trampolines || m_funcsNum == MAX_FUNCS)
+                {
+                    continue;
+                }
+
+                m_funcs[m_funcsNum] = {m_vTableOffsets.at(name), (*trampolines)[m_funcsNum]};
+                m_funcIds.try_emplace(name, m_funcsNum++);
+            }
         }
         catch (const YAML::BadFile &e [[maybe_unused]])
         {
@@ -338,41 +482,31 @@ VTableHookManager::VTableHookManager(const fs::path &configsDir, ModType modType
     }
 }
 
-VTableHook *VTableHookManager::registerHook(VTableHookManager::vFuncType vFunc, std::string_view classname)
+VTableHook *VTableHookManager::registerHook(VTableHookManager::vFuncType vFunc,
+                                            std::string_view classname,
+                                            const VTableHookFilter *filter)
 {
-    std::uint32_t vFuncOffset = 0;
-    std::intptr_t hookFunc;
-    try
+    auto index = static_cast<std::size_t>(vFunc);
+    if (index >= std::size(gBuiltinFuncs))
     {
-        switch (vFunc)
-        {
-            case vFuncType::Spawn:
-            {
-                vFuncOffset = m_vTableOffsets.at("spawn");
-                hookFunc = reinterpret_cast<std::intptr_t>(vSpawnHook);
-                break;
-            }
-            case vFuncType::TakeDamage:
-            {
-                vFuncOffset = m_vTableOffsets.at("takedamage");
-                hookFunc = reinterpret_cast<std::intptr_t>(vTakeDamageHook);
-                break;
-            }
-            case vFuncType::TraceAttack:
-            {
-                vFuncOffset = m_vTableOffsets.at("traceattack");
-                hookFunc = reinterpret_cast<std::intptr_t>(vTraceAttack);
-                break;
-            }
-            default:
-                return nullptr;
-        }
+        return nullptr;
     }
-    catch (const std::exception &e  [[maybe_unused]])
+
+    return registerHook(gBuiltinFuncs[index].first, classname, filter);
+}
+
+VTableHook *VTableHookManager::registerHook(std::string_view function,
+                                            std::string_view classname,
+                                            const VTableHookFilter *filter)
+{
+    auto funcIter = m_funcIds.find(std::string(function));
+    if (funcIter == m_funcIds.end())
     {
         return nullptr;
     }
 
+    const VFunc &vFunc = m_funcs[funcIter->second];
+
     edict_t *pEdict = CREATE_ENTITY();
 
     CALL_GAME_ENTITY(PLID, classname.data(), &pEdict->v);
@@ -391,34 +525,19 @@ VTableHook *VTableHookManager::registerHook(VTableHookManager::vFuncType vFunc,
         return nullptr;
     }
 
-    std::intptr_t entry = vtable + sizeof(std::intptr_t) * vFuncOffset;
+    std::intptr_t entry = vtable + sizeof(std::intptr_t) * vFunc.offset;
 
-    if (auto hook = _getHook(vtable, entry); hook)
+    // Every class has its own vtable, so it gets its own hook
+    auto result = m_hooks.try_emplace(entry, nullptr);
+    if (result.second)
     {
-        return hook;
+        result.first->second = std::make_unique<VTableHook>(vtable, entry, vFunc.trampoline, m_callbacks);
     }
 
-    auto result = m_hooks.emplace(vFunc, std::make_unique<VTableHook>(vtable, entry, hookFunc, m_callbacks));
-
-    return result.first->second.get();
-}
-
-VTableHook *VTableHookManager::getHook(vFuncType funcType) const
-{
-    return m_hooks.at(funcType).get();
-}
-
-VTableHook *VTableHookManager::_getHook(std::intptr_t vtable, std::intptr_t entryFunc)
-{
-    for (auto &[funcType, hook] : m_hooks)
-    {
-        if (hook->getVTable() == vtable && hook->getEntryFunc() == entryFunc)
-        {
-            return hook.get();
-        }
-    }
+    VTableHook *hook = result.first->second.get();
+    hook->addFilter(filter);
 
-    return nullptr;
+    return hook;
 }
 
 std::uint32_t VTableHookManager::getPevOffset() const
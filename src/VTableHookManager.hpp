@@ -24,6 +24,28 @@
 class VTableHook : public IVTableHook
 {
 public:
+    /* Frames are preallocated for that many nested calls, deeper ones add frames once */
+    static constexpr std::size_t MAX_CALL_DEPTH = 16;
+
+    /* Enough for any hooked function, params storage is reserved upfront */
+    static constexpr std::size_t MAX_PARAMS = 8;
+
+    /* State of a single hooked call */
+    struct Frame
+    {
+        Frame()
+        {
+            params.reserve(MAX_PARAMS);
+        }
+
+        std::vector<Param> params;
+        std::optional<Param> originalReturn;
+        std::optional<Param> returnValue;
+
+        /* Wrapper of trace result passed to callbacks */
+        std::optional<Engine::TraceResult> traceResult;
+    };
+
     VTableHook(std::intptr_t vtable, std::intptr_t entry, std::intptr_t hook, const std::vector<Callback> &callbacks);
     ~VTableHook();
 
@@ -34,70 +56,90 @@ public:
 
     Return execCallbacks(bool post = false);
 
+    /* Calls the original function without touching the current frame */
     template<typename ReturnType = void, typename... Args>
-    ReturnType execOriginalFunc(void *instance, Args... args)
+    ReturnType callOriginalFunc(void *instance, Args... args) const
     {
 #if defined SP_POSIX
+        return reinterpret_cast<ReturnType (*)(void *, Args...)>(m_original)(instance, args...);
+#else
+        return reinterpret_cast<ReturnType(__fastcall *)(void *, int, Args...)>(m_original)(instance, 0, args...);
+#endif
+    }
+
+    template<typename ReturnType = void, typename... Args>
+    ReturnType execOriginalFunc(void *instance, Args... args)
+    {
         if constexpr (std::is_same_v<ReturnType, void>)
         {
-            reinterpret_cast<ReturnType (*)(void *, Args...)>(m_original)(instance, args...);
+            callOriginalFunc<ReturnType, Args...>(instance, args...);
         }
         else
         {
-            ReturnType result = reinterpret_cast<ReturnType (*)(void *, Args...)>(m_original)(instance, args...);
-            if (m_originalReturn.size())
+            ReturnType result = callOriginalFunc<ReturnType, Args...>(instance, args...);
+            if (m_depth)
             {
-                m_originalReturn.top() = result;
+                _getFrame().originalReturn = result;
             }
 
             return result;
         }
-#else
-        if constexpr (std::is_same_v<ReturnType, void>)
+    }
+
+    /* Merges filter of a registration, nullptr or empty filter lets every entity through */
+    void addFilter(const VTableHookFilter *filter);
+
+    /* Checks if call for the entity should go through callbacks */
+    bool passesFilter(std::uint32_t index, const entvars_t *pev) const
+    {
+        if (m_passAll || (index < m_filterIndexes.size() && m_filterIndexes.test(index)))
         {
-            reinterpret_cast<ReturnType(__fastcall *)(void *, int, Args...)>(m_original)(instance, 0, args...);
+            return true;
         }
-        else
-        {
-            ReturnType result =
-                reinterpret_cast<ReturnType(__fastcall *)(void *, int, Args...)>(m_original)(instance, 0, args...);
 
-            if (m_originalReturn.size())
-            {
-                m_originalReturn.top() = result;
-            }
-
-            return result;
+        if (m_filterPlayers && index && index <= static_cast<std::uint32_t>(gpGlobals->maxClients))
+        {
+            return true;
         }
-#endif
+
+        return !m_filterClassnames.empty() && _matchesClassname(pev);
     }
 
     const std::vector<Param> &packParams()
     {
-        return m_params.top();
+        return _getFrame().params;
     }
 
     template<typename T, typename... Args, typename = std::enable_if_t<std::is_convertible_v<T, Param>>>
     const std::vector<Param> &packParams(T arg, Args... args)
     {
-        m_params.top().emplace_back(arg);
+        _getFrame().params.emplace_back(arg);
         return packParams(args...);
     }
 
     void prepareForCall()
     {
-        m_params.emplace();
-        m_status.emplace();
-        m_originalReturn.emplace();
-        m_return.emplace();
+        if (m_depth == m_frames.size())
+        {
+            m_frames.emplace_back();
+        }
+
+        Frame &frame = m_frames[m_depth++];
+        frame.params.clear();
+        frame.originalReturn.reset();
+        frame.returnValue.reset();
     }
 
     void cleanup()
     {
-        m_params.pop();
-        m_status.pop();
-        m_originalReturn.pop();
-        m_return.pop();
+        _getFrame().traceResult.reset();
+        m_depth--;
+    }
+
+    /* Trace result wrapper valid until cleanup() */
+    Engine::TraceResult *wrapTraceResult(::TraceResult *traceResult)
+    {
+        return &_getFrame().traceResult.emplace(traceResult);
     }
 
     std::intptr_t getEntryFunc() const;
@@ -110,20 +152,46 @@ private:
 
     const std::vector<Callback> &m_callbacks;
 
-    std::stack<std::vector<Param>> m_params;
-    std::stack<Return> m_status;
-    std::stack<std::optional<Param>> m_originalReturn;
-    std::stack<std::optional<Param>> m_return;
+    /* Union of filters of all registrations */
+    bool m_passAll;
+    bool m_filterPlayers;
+    std::bitset<VTableHookFilter::MAX_ENTITIES> m_filterIndexes;
+    std::vector<std::string> m_filterClassnames;
+
+    bool _matchesClassname(const entvars_t *pev) const;
+
+    Frame &_getFrame()
+    {
+        return m_frames[m_depth - 1];
+    }
+
+    /* Deque keeps frames in place when a deeper call adds one */
+    std::deque<Frame> m_frames;
+    std::size_t m_depth;
 };
 
 class VTableHookManager : public IVTableHookManager
 {
 public:
+    /* Max number of hookable functions, each has its own trampolines */
+    static constexpr std::size_t MAX_FUNCS = 32;
+
     VTableHookManager() = delete;
     VTableHookManager(const fs::path &configsDir, ModType modType);
 
-    VTableHook *registerHook(vFuncType vFunc, std::string_view classname) override;
-    VTableHook *getHook(vFuncType funcType) const;
+    VTableHook *registerHook(vFuncType vFunc,
+                             std::string_view classname,
+                             const VTableHookFilter *filter = nullptr) override;
+    VTableHook *registerHook(std::string_view function,
+                             std::string_view classname,
+                             const VTableHookFilter *filter = nullptr) override;
+
+    /* Finds hook of the function in vtable of the instance */
+    VTableHook *getHook(const void *instance, std::size_t func) const
+    {
+        std::intptr_t vtable = *reinterpret_cast<const std::intptr_t *>(instance);
+        return m_hooks.find(vtable + sizeof(std::intptr_t) * m_funcs[func].offset)->second.get();
+    }
 
     void addCallback(VTableHook::Callback callback) override;
     std::uint32_t getPevOffset() const;
@@ -132,10 +200,19 @@ public:
     void ServerDeactivatePost();
 
 private:
-    VTableHook *_getHook(std::intptr_t vtable, std::intptr_t entryFunc);
+    /* Hookable function, with signature given in gamedata */
+    struct VFunc
+    {
+        std::uint32_t offset;
+        std::intptr_t trampoline;
+    };
 
-private:
-    std::unordered_map<vFuncType, std::unique_ptr<VTableHook>> m_hooks;
+    /* Hooks keyed by address of the vtable entry, that is by vtable and function */
+    std::unordered_map<std::intptr_t, std::unique_ptr<VTableHook>> m_hooks;
+
+    std::array<VFunc, MAX_FUNCS> m_funcs;
+    std::size_t m_funcsNum;
+    std::unordered_map<std::string, std::size_t> m_funcIds;
     std::unordered_map<std::string, std::uint32_t> m_vTableOffsets;
     std::vector<VTableHook::Callback> m_callbacks;
 };
\ No newline at end of file
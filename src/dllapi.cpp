@@ -33,12 +33,13 @@ static void ClientCommand(edict_t *pEntity)
 {
     {
         int result;
-        auto fwdCmd = gSPGlobal->getForwardManager()->getForward(ForwardMngr::FWD_PLAYER_COMMAND);
+        auto fwdCmd = gSPGlobal->getForwardManager()->getForward(ForwardMngr::DefaultForward::PlayerCommand);
 
         if (!fwdCmd)
             RETURN_META(MRES_IGNORED);
 
         fwdCmd->pushInt(ENTINDEX(pEntity));
+        fwdCmd->pushString(CMD_ARGV(0));
         fwdCmd->execFunc(&result);
 
         if (static_cast<IForward::ReturnValue>(result) == IForward::ReturnValue::Stop)
@@ -134,15 +135,15 @@ static void ServerActivatePost(edict_t *pEdictList, int edictCount [[maybe_unuse
     }
 
     // Allow plugins to add their natives
-    fwdMngr->getForward(ForwardMngr::FWD_PLUGIN_NATIVES)->execFunc(nullptr);
+    fwdMngr->getForward(ForwardMngr::DefaultForward::PluginNatives)->execFunc(nullptr);
 
     for (auto &interface : gSPGlobal->getAdaptersInterfaces())
     {
         interface.second->getPluginMngr()->bindPluginsNatives();
     }
 
-    fwdMngr->getForward(ForwardMngr::FWD_PLUGIN_INIT)->execFunc(nullptr);
-    fwdMngr->getForward(ForwardMngr::FWD_PLUGINS_LOADED)->execFunc(nullptr);
+    fwdMngr->getForward(ForwardMngr::DefaultForward::PluginInit)->execFunc(nullptr);
+    fwdMngr->getForward(ForwardMngr::DefaultForward::PluginsLoaded)->execFunc(nullptr);
 
     gSPGlobal->allowPrecacheForPlugins(false);
 
@@ -152,7 +153,10 @@ static void ServerActivatePost(edict_t *pEdictList, int edictCount [[maybe_unuse
 static void ServerDeactivatePost()
 {
     auto fwdMngr = gSPGlobal->getForwardManager();
-    fwdMngr->getForward(ForwardMngr::FWD_PLUGIN_END)->execFunc(nullptr);
+
+    // Deliver events from the last frame before plugins are gone
+    fwdMngr->execDeferred();
+    fwdMngr->getForward(ForwardMngr::DefaultForward::PluginEnd)->execFunc(nullptr);
 
     for (auto &interface : gSPGlobal->getAdaptersInterfaces())
     {
@@ -202,6 +206,7 @@ static void ClientUserInfoChangedPost(edict_t *pEntity, char *infobuffer)
 static void StartFramePost()
 {
     gSPGlobal->getPlayerManager()->StartFramePost();
+    gSPGlobal->getForwardManager()->execDeferred();
 
     if (TimerMngr::m_nextExecution <= gpGlobals->time)
     {
@@ -80,9 +80,10 @@ namespace SPMod::Engine
 
     void Funcs::messageBegin(MsgDest msgDest, std::uint32_t msgType, const float *pOrigin, IEdict *pEdict) const
     {
-        (m_hook) ? gpEngineFuncs->pfnMessageBegin(static_cast<std::int32_t>(msgDest), msgType, pOrigin,
-                                                  INDEXENT(pEdict->getIndex()))
-                 : MESSAGE_BEGIN(static_cast<std::int32_t>(msgDest), msgType, pOrigin, INDEXENT(pEdict->getIndex()));
+        edict_t *edict = pEdict ? INDEXENT(pEdict->getIndex()) : nullptr;
+
+        (m_hook) ? gpEngineFuncs->pfnMessageBegin(static_cast<std::int32_t>(msgDest), msgType, pOrigin, edict)
+                 : MESSAGE_BEGIN(static_cast<std::int32_t>(msgDest), msgType, pOrigin, edict);
     }
 
     void Funcs::messageEnd() const
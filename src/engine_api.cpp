@@ -22,7 +22,7 @@
 static void ChangeLevel(const char *s1, const char *s2 [[maybe_unused]])
 {
     auto fwdMngr = gSPGlobal->getForwardManager();
-    auto fwdMapChange = fwdMngr->getForward(ForwardMngr::FWD_MAP_CHANGE);
+    auto fwdMapChange = fwdMngr->getForward(ForwardMngr::DefaultForward::MapChange);
     std::int32_t result;
 
     fwdMapChange->pushString(s1);
@@ -57,6 +57,12 @@ static void MessageEnd_Pre(void)
     
     RETURN_META(ret);
 }
+static void MessageEnd_Post(void)
+{
+    gSPGlobal->getMessageManager()->MessageEndPost();
+
+    RETURN_META(MRES_IGNORED);
+}
 static void WriteByte_Pre(int iValue)
 {
     META_RES ret = MRES_IGNORED;
@@ -355,7 +361,7 @@ enginefuncs_t gEngineFunctionsTablePost = {
     nullptr,         // pfnDecalIndex()
     nullptr,         // pfnPointContents()
     nullptr,         // pfnMessageBegin()
-    nullptr,         // pfnMessageEnd()
+    MessageEnd_Post, // pfnMessageEnd()
     nullptr,         // pfnWriteByte()
     nullptr,         // pfnWriteChar()
     nullptr,         // pfnWriteShort()
@@ -100,7 +100,7 @@ C_DLLEXPORT int Meta_Attach(PLUG_LOADTIME now [[maybe_unused]],
 C_DLLEXPORT int Meta_Detach(PLUG_LOADTIME now [[maybe_unused]], PL_UNLOAD_REASON reason [[maybe_unused]])
 {
     auto fwdMngr = gSPGlobal->getForwardManager();
-    fwdMngr->getForward(ForwardMngr::FWD_PLUGIN_END)->execFunc(nullptr);
+    fwdMngr->getForward(ForwardMngr::DefaultForward::PluginEnd)->execFunc(nullptr);
     fwdMngr->clearForwards();
 
     gSPGlobal->getTimerManager()->clearTimers();
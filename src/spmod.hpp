@@ -56,11 +56,17 @@
 // STL C++
 #include <memory>
 #include <vector>
+#include <algorithm>
 #include <sstream>
 #include <unordered_map>
 #include <exception>
 #include <fstream>
 #include <stack>
+#include <deque>
+#include <map>
+#include <bitset>
+#include <chrono>
+#include <iomanip>
 
 #include <yaml-cpp/yaml.h>
 
@@ -71,7 +71,15 @@ static cell_t CommandCtor(SourcePawn::IPluginContext *ctx, const cell_t *params)
                                            callback);
     }
 
-    return gCommandHandlers.create(pCmd);
+    // Command stays registered, engine cannot forget it anyway
+    std::size_t id = gCommandHandlers.create(pCmd);
+    if (id == TypeHandler<SPMod::ICommand>::INVALID_HANDLE)
+    {
+        ctx->ReportError("Too many commands");
+        return -1;
+    }
+
+    return id;
 }
 
 // int GetInfo(char[] buffer, int size)
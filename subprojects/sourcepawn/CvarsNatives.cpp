@@ -40,12 +40,15 @@ static cell_t CvarRegister(SourcePawn::IPluginContext *ctx, const cell_t *params
     if (!plCvar)
         return -1;
 
-    std::size_t id = gCvarsHandlers.getKey(plCvar);
-
-    if (id != static_cast<std::size_t>(-1))
-        return id;
+    // Cvar stays registered, engine cannot forget it anyway
+    std::size_t id = gCvarsHandlers.create(plCvar);
+    if (id == TypeHandler<SPMod::ICvar>::INVALID_HANDLE)
+    {
+        ctx->ReportError("Too many cvars");
+        return -1;
+    }
 
-    return gCvarsHandlers.create(plCvar);
+    return id;
 }
 
 static cell_t CvarGetName(SourcePawn::IPluginContext *ctx, const cell_t *params)
@@ -350,12 +353,15 @@ static cell_t CvarFind(SourcePawn::IPluginContext *ctx, const cell_t *params)
     if (!plCvar)
         return -1;
 
-    std::size_t id = gCvarsHandlers.getKey(plCvar);
-
-    if (id != static_cast<std::size_t>(-1))
-        return id;
+    // Cvar stays registered, engine cannot forget it anyway
+    std::size_t id = gCvarsHandlers.create(plCvar);
+    if (id == TypeHandler<SPMod::ICvar>::INVALID_HANDLE)
+    {
+        ctx->ReportError("Too many cvars");
+        return -1;
+    }
 
-    return gCvarsHandlers.create(plCvar);
+    return id;
 }
 
 sp_nativeinfo_t gCvarsNatives[] = {{"Cvar.Cvar", CvarRegister},
@@ -138,14 +138,13 @@ namespace
 
     bool pushParamsToFunc(SPMod::IForward *fwd, SourcePawn::IPluginFunction *func, cell_t *result)
     {
-        using variantArray = std::variant<int *, float *>;
-
         if (!func || !func->IsRunnable())
             return false;
 
         for (const auto param : fwd->getParams())
         {
             auto paramType = param->getDataType();
+            SPMod::IForward::IParam::Data paramData = param->getData();
 
             if (paramType & SPMod::IForward::IParam::Type::Int || paramType & SPMod::IForward::IParam::Type::Float)
             {
@@ -153,27 +152,25 @@ namespace
                 {
                     if (paramType & SPMod::IForward::IParam::Type::Int)
                     {
-                        int *paramData = std::get<int *>(std::any_cast<variantArray>(param->getData()));
-                        func->PushArray(paramData, param->getDataSize(),
+                        func->PushArray(std::get<std::int32_t *>(paramData), param->getDataSize(),
                                         (param->shouldCopyback() ? SM_PARAM_COPYBACK : 0));
                     }
                     else
                     {
-                        float *paramData = std::get<float *>(std::any_cast<variantArray>(param->getData()));
-                        func->PushArray(reinterpret_cast<cell_t *>(paramData), param->getDataSize(),
-                                        (param->shouldCopyback() ? SM_PARAM_COPYBACK : 0));
+                        func->PushArray(reinterpret_cast<cell_t *>(std::get<float *>(paramData)),
+                                        param->getDataSize(), (param->shouldCopyback() ? SM_PARAM_COPYBACK : 0));
                     }
                 }
                 else if (paramType & SPMod::IForward::IParam::Type::Pointer)
                 {
                     if (paramType & SPMod::IForward::IParam::Type::Int)
                     {
-                        func->PushCellByRef(std::any_cast<int *>(param->getData()),
+                        func->PushCellByRef(std::get<std::int32_t *>(paramData),
                                             (param->shouldCopyback() ? SM_PARAM_COPYBACK : 0));
                     }
                     else
                     {
-                        func->PushFloatByRef(std::any_cast<float *>(param->getData()),
+                        func->PushFloatByRef(std::get<float *>(paramData),
                                              (param->shouldCopyback() ? SM_PARAM_COPYBACK : 0));
                     }
                 }
@@ -181,11 +178,11 @@ namespace
                 {
                     if (paramType & SPMod::IForward::IParam::Type::Int)
                     {
-                        func->PushCell(std::any_cast<int>(param->getData()));
+                        func->PushCell(std::get<std::int32_t>(paramData));
                     }
                     else
                     {
-                        func->PushFloat(std::any_cast<float>(param->getData()));
+                        func->PushFloat(std::get<float>(paramData));
                     }
                 }
             }
@@ -194,7 +191,7 @@ namespace
                 if (param->shouldCopyback() || param->getStringFlags() != SPMod::IForward::StringFlags::None)
                 {
                     int spStringFlags = 0;
-                    auto stringFlags = SPMod::IForward::StringFlags::None;
+                    auto stringFlags = param->getStringFlags();
 
                     if (stringFlags & SPMod::IForward::StringFlags::Utf8)
                         spStringFlags |= SM_PARAM_STRING_UTF8;
@@ -205,12 +202,12 @@ namespace
                     if (stringFlags & SPMod::IForward::StringFlags::Binary)
                         spStringFlags |= SM_PARAM_STRING_BINARY;
 
-                    func->PushStringEx(std::any_cast<char *>(param->getData()), param->getDataSize(),
-                                       (param->shouldCopyback() ? SM_PARAM_COPYBACK : 0), spStringFlags);
+                    func->PushStringEx(std::get<char *>(paramData), param->getDataSize(),
+                                       spStringFlags, (param->shouldCopyback() ? SM_PARAM_COPYBACK : 0));
                 }
                 else
                 {
-                    func->PushString(std::any_cast<std::string>(param->getData()).c_str());
+                    func->PushString(std::get<const char *>(paramData));
                 }
             }
         }
@@ -241,17 +238,34 @@ SPMOD_API bool SPMod_Init()
     gSPAPI = std::make_unique<SourcePawnAPI>(gSPGlobal->getPath(SPMod::DirType::Exts));
 
     gSPFwdMngr->addForwardListener([](SPMod::IForward *const fwd, int &result, bool &stop) {
+        // Only plugins implementing the forward are visited
+        const auto &subscribers = gAdapterInterface->getPluginMngr()->getForwardSubscribers(fwd);
+        bool profiling = gSPFwdMngr->isProfiling();
+
+        auto execFunc = [fwd, profiling, &subscribers](std::size_t index, cell_t *fwdResult) {
+            if (!profiling)
+                return pushParamsToFunc(fwd, subscribers.functions[index], fwdResult);
+
+            auto start = std::chrono::steady_clock::now();
+            bool succeed = pushParamsToFunc(fwd, subscribers.functions[index], fwdResult);
+            auto elapsed = std::chrono::steady_clock::now() - start;
+
+            gSPFwdMngr->addProfileSample(fwd, subscribers.plugins[index],
+                                         std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            return succeed;
+        };
+
         // One plugin forward
-        Plugin *fwdPlugin = gAdapterInterface->getPluginMngr()->getPlugin(fwd->getPlugin());
-        if (fwdPlugin)
+        if (fwd->getPlugin())
         {
-            SourcePawn::IPluginFunction *func = fwdPlugin->getRuntime()->GetFunctionByName(fwd->getName().data());
+            if (subscribers.functions.empty())
+                return;
 
-            if (!func || !func->IsRunnable())
+            if (!subscribers.functions.front()->IsRunnable() || !fwd->passesFilters(subscribers.plugins.front()))
                 return;
 
             cell_t fwdResult = 0;
-            if (!pushParamsToFunc(fwd, func, &fwdResult))
+            if (!execFunc(0, &fwdResult))
             {
                 return;
             }
@@ -262,16 +276,13 @@ SPMOD_API bool SPMod_Init()
         {
             SPMod::IForward::ExecType execType = fwd->getExecType();
 
-            for (const auto &pair : gAdapterInterface->getPluginMngr()->getPluginsListCore())
+            for (std::size_t i = 0; i < subscribers.functions.size(); i++)
             {
-                Plugin *plugin = pair.second.get();
-                SourcePawn::IPluginFunction *func = plugin->getRuntime()->GetFunctionByName(fwd->getName().data());
-
-                if (!func || !func->IsRunnable())
+                if (!subscribers.functions[i]->IsRunnable() || !fwd->passesFilters(subscribers.plugins[i]))
                     continue;
 
                 cell_t fwdResult = 0;
-                bool succeed = pushParamsToFunc(fwd, func, &fwdResult);
+                bool succeed = execFunc(i, &fwdResult);
 
                 if (!succeed || execType & SPMod::IForward::ExecType::Ignore)
                     continue;
@@ -293,8 +304,8 @@ SPMOD_API bool SPMod_Init()
     });
 
     gSPVTHookMngr->addCallback([](SPMod::IVTableHook *const hook, bool post) {
-        std::pair<std::unordered_multimap<SPMod::IVTableHook *, SourcePawn::IPluginFunction *>::iterator,
-            std::unordered_multimap<SPMod::IVTableHook *, SourcePawn::IPluginFunction *>::iterator>
+        std::pair<std::unordered_multimap<SPMod::IVTableHook *, VTableHookCallback>::iterator,
+            std::unordered_multimap<SPMod::IVTableHook *, VTableHookCallback>::iterator>
             range;
         if (!post)
         {
@@ -305,10 +316,20 @@ SPMOD_API bool SPMod_Init()
             range = gVTableHookPost.equal_range(hook);
         }
 
+        // Hook is shared, other plugins might have wanted calls of any entity
+        auto isPlayer = [hook]() {
+            const auto &params = hook->getParams();
+            auto index = params.empty() ? 0 : std::get<std::uint32_t>(params[0]);
+            return index && index <= gSPPlrMngr->getMaxClients();
+        };
+
         cell_t finalResult = 0;
         for (auto it = range.first; it != range.second; it++)
         {
-            SourcePawn::IPluginFunction *func = it->second;
+            SourcePawn::IPluginFunction *func = it->second.func;
+            if (it->second.playersOnly && !isPlayer())
+                continue;
+
             if (func && func->IsRunnable())
             {
                 cell_t result = 0;
@@ -336,7 +357,7 @@ SPMOD_API bool SPMod_Init()
                           else if constexpr (std::is_same_v<T, SPMod::Engine::IEntVars *> ||
                                              std::is_same_v<T, SPMod::Engine::IEdict *>)
                           {
-                              func->PushCell(arg->getIndex());
+                              func->PushCell(arg ? static_cast<cell_t>(arg->getIndex()) : 0);
                           }
                           else if constexpr (std::is_same_v<T, SPMod::Engine::ITraceResult *>)
                           {
@@ -26,6 +26,7 @@
 #include <cstdarg>
 #include <cmath>
 #include <stack>
+#include <chrono>
 
 #if defined SP_POSIX
     #include <dlfcn.h>
@@ -82,8 +83,17 @@ extern TypeHandler<SPMod::IMenu> gMenuHandlers;
 // TimerNatives.cpp
 extern TypeHandler<SPMod::ITimer> gTimerHandlers;
 
-extern std::unordered_multimap<SPMod::IVTableHook *, SourcePawn::IPluginFunction *> gVTableHook;
-extern std::unordered_multimap<SPMod::IVTableHook *, SourcePawn::IPluginFunction *> gVTableHookPost;
+// VTableNatives.cpp
+struct VTableHookCallback
+{
+    SourcePawn::IPluginFunction *func;
+
+    // Calls of non-player entities are skipped
+    bool playersOnly;
+};
+
+extern std::unordered_multimap<SPMod::IVTableHook *, VTableHookCallback> gVTableHook;
+extern std::unordered_multimap<SPMod::IVTableHook *, VTableHookCallback> gVTableHookPost;
 extern TypeHandler<SPMod::IVTableHook> gVTableHandlers;
 
 extern SPMod::ILogger *gSPLogger;
@@ -101,6 +111,9 @@ constexpr void menuUnpackItem(std::size_t index, cell_t &menuid, cell_t &itemid)
 
 extern TypeHandler<SPMod::Engine::ITraceResult> gTraceResultHandlers;
 
+// MessageNatives.cpp
+void clearMessageTemplates();
+
 constexpr const char *gSPExtLoggerName = "SPExt";
 
 // Natives
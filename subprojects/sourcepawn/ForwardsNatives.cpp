@@ -91,7 +91,15 @@ static cell_t ForwardCtor(SourcePawn::IPluginContext *ctx, const cell_t *params)
         return -1;
     }
 
-    return gForwardHandlers.create(forward);
+    std::size_t id = gForwardHandlers.create(forward);
+    if (id == TypeHandler<SPMod::IForward>::INVALID_HANDLE)
+    {
+        gSPFwdMngr->deleteForward(forward);
+        ctx->ReportError("Too many forwards");
+        return -1;
+    }
+
+    return id;
 }
 
 // bool PushCell(any cell)
@@ -412,6 +420,104 @@ static cell_t ForwardRemove(SourcePawn::IPluginContext *ctx, const cell_t *param
     return 1;
 }
 
+static cell_t addForwardFilter(SourcePawn::IPluginContext *ctx,
+                               cell_t fwdName,
+                               const SPMod::IForward::Filter &filter)
+{
+    char *name;
+    ctx->LocalToString(fwdName, &name);
+
+    SPMod::IForward *forward = gSPFwdMngr->getForward(name);
+    if (!forward)
+    {
+        ctx->ReportError("Forward not found");
+        return 0;
+    }
+
+    return forward->addFilter(gAdapterInterface->getPluginMngr()->getPlugin(ctx), filter);
+}
+
+// native bool ForwardFilterString(const char[] forward, int param, const char[] string)
+static cell_t ForwardFilterString(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_forward = 1,
+        arg_param,
+        arg_string
+    };
+
+    char *string;
+    ctx->LocalToString(params[arg_string], &string);
+
+    SPMod::IForward::Filter filter = {};
+    filter.type = SPMod::IForward::Filter::Type::String;
+    filter.param = params[arg_param];
+    filter.string = string;
+
+    return addForwardFilter(ctx, params[arg_forward], filter);
+}
+
+// native bool ForwardFilterRange(const char[] forward, int param, int min, int max)
+static cell_t ForwardFilterRange(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_forward = 1,
+        arg_param,
+        arg_min,
+        arg_max
+    };
+
+    SPMod::IForward::Filter filter = {};
+    filter.type = SPMod::IForward::Filter::Type::IntRange;
+    filter.param = params[arg_param];
+    filter.min = params[arg_min];
+    filter.max = params[arg_max];
+
+    return addForwardFilter(ctx, params[arg_forward], filter);
+}
+
+// native bool ForwardFilterPlayers(const char[] forward, int param, int players)
+static cell_t ForwardFilterPlayers(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_forward = 1,
+        arg_param,
+        arg_players
+    };
+
+    SPMod::IForward::Filter filter = {};
+    filter.type = SPMod::IForward::Filter::Type::PlayerMask;
+    filter.param = params[arg_param];
+    filter.players = static_cast<std::uint32_t>(params[arg_players]);
+
+    return addForwardFilter(ctx, params[arg_forward], filter);
+}
+
+// native void ForwardFilterClear(const char[] forward)
+static cell_t ForwardFilterClear(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_forward = 1
+    };
+
+    char *name;
+    ctx->LocalToString(params[arg_forward], &name);
+
+    SPMod::IForward *forward = gSPFwdMngr->getForward(name);
+    if (!forward)
+    {
+        ctx->ReportError("Forward not found");
+        return 0;
+    }
+
+    forward->removeFilters(gAdapterInterface->getPluginMngr()->getPlugin(ctx));
+    return 1;
+}
+
 sp_nativeinfo_t gForwardsNatives[] = {{"Forward.Forward", ForwardCtor},
                                       {"Forward.PushCell", PushCell},
                                       {"Forward.PushCellRef", PushCellRef},
@@ -424,4 +530,8 @@ sp_nativeinfo_t gForwardsNatives[] = {{"Forward.Forward", ForwardCtor},
                                       {"Forward.PushExec", PushExec},
                                       {"Forward.PushCancel", PushCancel},
                                       {"Forward.Remove", ForwardRemove},
+                                      {"ForwardFilterString", ForwardFilterString},
+                                      {"ForwardFilterRange", ForwardFilterRange},
+                                      {"ForwardFilterPlayers", ForwardFilterPlayers},
+                                      {"ForwardFilterClear", ForwardFilterClear},
                                       {nullptr, nullptr}};
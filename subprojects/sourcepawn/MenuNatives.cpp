@@ -79,7 +79,15 @@ static cell_t MenuCreate(SourcePawn::IPluginContext *ctx, const cell_t *params)
     if (!pMenu)
         return -1;
 
-    return gMenuHandlers.create(pMenu);
+    std::size_t id = gMenuHandlers.create(pMenu);
+    if (id == TypeHandler<SPMod::IMenu>::INVALID_HANDLE)
+    {
+        gSPMenuMngr->destroyMenu(pMenu);
+        ctx->ReportError("Too many menus");
+        return -1;
+    }
+
+    return id;
 }
 
 // native void SetTitle(const char title[]);
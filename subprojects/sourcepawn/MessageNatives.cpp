@@ -21,6 +21,23 @@
 
 bool ignoreHooks;
 TypeHandler<SPMod::IMessageHook> gMessageHooks;
+TypeHandler<SPMod::IMessageTemplate> gMessageTemplates;
+
+// Values of string slots, plugins cannot pass strings in values array
+static std::unordered_map<SPMod::IMessageTemplate *, std::vector<std::string>> gTemplateStrings;
+
+static bool isValidParamType(cell_t type)
+{
+    return type >= static_cast<cell_t>(SPMod::MsgParamType::Byte) &&
+           type <= static_cast<cell_t>(SPMod::MsgParamType::Entity);
+}
+
+void clearMessageTemplates()
+{
+    // Templates are destroyed by message manager on map change
+    gTemplateStrings.clear();
+    gMessageTemplates.clear();
+}
 
 // int GetUserMsgId(const char[] msgname);
 static cell_t GetUserMsgId(SourcePawn::IPluginContext *ctx, const cell_t *params)
@@ -95,6 +112,41 @@ static cell_t HookMessage(SourcePawn::IPluginContext *ctx, const cell_t *params)
     return gMessageHooks.create(hook);
 }
 
+// native MessageHook ObserveMessage(int msgtype, MessageHandler handler);
+static cell_t ObserveMessage(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_msg_type = 1,
+        arg_handler
+    };
+
+    SourcePawn::IPluginFunction *func = ctx->GetFunctionById(params[arg_handler]);
+
+    if (params[arg_msg_type] < 0 || static_cast<unsigned int>(params[arg_msg_type]) >= SPMod::MAX_USER_MESSAGES)
+    {
+        ctx->ReportError("Invalid message id (%d).", params[arg_msg_type]);
+        return -1;
+    }
+
+    SPMod::IMessageHook *hook =
+        gSPMsgMngr->registerObserver(params[arg_msg_type], [func](SPMod::IMessage *const message) {
+            if (func && func->IsRunnable())
+            {
+                SPMod::Engine::IEdict *edict = message->getEdict();
+
+                // Return value is ignored, message has already been sent
+                func->PushCell(static_cast<cell_t>(message->getDest()));
+                func->PushCell(message->getType());
+                func->PushCell(edict ? static_cast<cell_t>(edict->getIndex()) : 0);
+                func->Execute(nullptr);
+            }
+            return SPMod::IForward::ReturnValue::Ignored;
+        });
+
+    return gMessageHooks.create(hook);
+}
+
 // native void UnhookMessage(int msgtype, Message msghook);
 static cell_t UnhookMessage(SourcePawn::IPluginContext *ctx, const cell_t *params)
 {
@@ -116,6 +168,104 @@ static cell_t UnhookMessage(SourcePawn::IPluginContext *ctx, const cell_t *param
     return 1;
 }
 
+// native bool AddMsgHookCondition(MessageHook hook, MsgCondType type, int param = 0, any value = 0);
+static cell_t AddMsgHookCondition(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_hook_index = 1,
+        arg_type,
+        arg_param,
+        arg_value
+    };
+
+    SPMod::IMessageHook *hook = gMessageHooks.get(params[arg_hook_index]);
+
+    if (!hook)
+    {
+        ctx->ReportError("Invalid message hook id (%d).", params[arg_hook_index]);
+        return 0;
+    }
+
+    auto conditionType = static_cast<SPMod::MsgCondition::Type>(params[arg_type]);
+    if (conditionType == SPMod::MsgCondition::Type::ParamString ||
+        conditionType > SPMod::MsgCondition::Type::Players || params[arg_param] < 0)
+    {
+        ctx->ReportError("Invalid condition (%d).", params[arg_type]);
+        return 0;
+    }
+
+    SPMod::MsgCondition condition = {};
+    condition.type = conditionType;
+    condition.param = params[arg_param];
+    condition.value = params[arg_value];
+    condition.real = sp_ctof(params[arg_value]);
+    condition.dest = static_cast<SPMod::MsgDest>(params[arg_value]);
+    condition.players = static_cast<std::uint32_t>(params[arg_value]);
+
+    hook->addCondition(condition);
+
+    return 1;
+}
+
+// native bool AddMsgHookStringCondition(MessageHook hook, int param, const char[] string);
+static cell_t AddMsgHookStringCondition(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_hook_index = 1,
+        arg_param,
+        arg_string
+    };
+
+    SPMod::IMessageHook *hook = gMessageHooks.get(params[arg_hook_index]);
+
+    if (!hook)
+    {
+        ctx->ReportError("Invalid message hook id (%d).", params[arg_hook_index]);
+        return 0;
+    }
+
+    if (params[arg_param] < 0)
+    {
+        ctx->ReportError("Invalid argument number(%d).", params[arg_param]);
+        return 0;
+    }
+
+    char *string;
+    ctx->LocalToString(params[arg_string], &string);
+
+    SPMod::MsgCondition condition = {};
+    condition.type = SPMod::MsgCondition::Type::ParamString;
+    condition.param = params[arg_param];
+    condition.string = string;
+
+    hook->addCondition(condition);
+
+    return 1;
+}
+
+// native void ClearMsgHookConditions(MessageHook hook);
+static cell_t ClearMsgHookConditions(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_hook_index = 1
+    };
+
+    SPMod::IMessageHook *hook = gMessageHooks.get(params[arg_hook_index]);
+
+    if (!hook)
+    {
+        ctx->ReportError("Invalid message hook id (%d).", params[arg_hook_index]);
+        return 0;
+    }
+
+    hook->clearConditions();
+
+    return 1;
+}
+
 // native BlockType GetMsgBlock(int msgtype);
 static cell_t GetMsgBlock(SourcePawn::IPluginContext *ctx, const cell_t *params)
 {
@@ -361,6 +511,301 @@ static cell_t SetMsgArgString(SourcePawn::IPluginContext *ctx [[maybe_unused]],
     return 1;
 }
 
+// native MessageTemplate CreateMessageTemplate(int msgtype);
+static cell_t CreateMessageTemplate(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_msg_type = 1
+    };
+
+    SPMod::IMessageTemplate *msgTemplate = gSPMsgMngr->createTemplate(params[arg_msg_type]);
+
+    if (!msgTemplate)
+    {
+        ctx->ReportError("Invalid message id (%d).", params[arg_msg_type]);
+        return -1;
+    }
+
+    return gMessageTemplates.create(msgTemplate);
+}
+
+// native void DestroyMessageTemplate(MessageTemplate tmpl);
+static cell_t DestroyMessageTemplate(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_template = 1
+    };
+
+    SPMod::IMessageTemplate *msgTemplate = gMessageTemplates.get(params[arg_template]);
+
+    if (!msgTemplate)
+    {
+        ctx->ReportError("Invalid message template id (%d).", params[arg_template]);
+        return 0;
+    }
+
+    gTemplateStrings.erase(msgTemplate);
+    gMessageTemplates.free(params[arg_template]);
+    gSPMsgMngr->destroyTemplate(msgTemplate);
+
+    return 1;
+}
+
+// native void MessageTemplateAddArg(MessageTemplate tmpl, MsgArgType type, any value);
+static cell_t MessageTemplateAddArg(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_template = 1,
+        arg_type,
+        arg_value
+    };
+
+    SPMod::IMessageTemplate *msgTemplate = gMessageTemplates.get(params[arg_template]);
+
+    if (!msgTemplate)
+    {
+        ctx->ReportError("Invalid message template id (%d).", params[arg_template]);
+        return 0;
+    }
+
+    if (!isValidParamType(params[arg_type]))
+    {
+        ctx->ReportError("Invalid argument type (%d).", params[arg_type]);
+        return 0;
+    }
+
+    auto type = static_cast<SPMod::MsgParamType>(params[arg_type]);
+
+    switch (type)
+    {
+        case SPMod::MsgParamType::Angle:
+        case SPMod::MsgParamType::Coord:
+            msgTemplate->addParam(type, sp_ctof(params[arg_value]));
+            break;
+        case SPMod::MsgParamType::String:
+            ctx->ReportError("Use MessageTemplateAddString for string arguments.");
+            return 0;
+        default:
+            msgTemplate->addParam(type, static_cast<int>(params[arg_value]));
+            break;
+    }
+
+    return 1;
+}
+
+// native void MessageTemplateAddString(MessageTemplate tmpl, const char[] value);
+static cell_t MessageTemplateAddString(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_template = 1,
+        arg_value
+    };
+
+    SPMod::IMessageTemplate *msgTemplate = gMessageTemplates.get(params[arg_template]);
+
+    if (!msgTemplate)
+    {
+        ctx->ReportError("Invalid message template id (%d).", params[arg_template]);
+        return 0;
+    }
+
+    char *value;
+    ctx->LocalToString(params[arg_value], &value);
+
+    msgTemplate->addParam(SPMod::MsgParamType::String, std::string_view(value));
+
+    return 1;
+}
+
+// native int MessageTemplateAddSlot(MessageTemplate tmpl, MsgArgType type, const char[] name);
+static cell_t MessageTemplateAddSlot(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_template = 1,
+        arg_type,
+        arg_name
+    };
+
+    SPMod::IMessageTemplate *msgTemplate = gMessageTemplates.get(params[arg_template]);
+
+    if (!msgTemplate)
+    {
+        ctx->ReportError("Invalid message template id (%d).", params[arg_template]);
+        return -1;
+    }
+
+    if (!isValidParamType(params[arg_type]))
+    {
+        ctx->ReportError("Invalid argument type (%d).", params[arg_type]);
+        return -1;
+    }
+
+    char *name;
+    ctx->LocalToString(params[arg_name], &name);
+
+    std::size_t slot = msgTemplate->addSlot(static_cast<SPMod::MsgParamType>(params[arg_type]), name);
+
+    if (slot == SPMod::IMessageTemplate::INVALID_SLOT)
+    {
+        ctx->ReportError("Slot \"%s\" already exists.", name);
+        return -1;
+    }
+
+    gTemplateStrings[msgTemplate].resize(msgTemplate->getSlots());
+
+    return static_cast<cell_t>(slot);
+}
+
+// native int MessageTemplateFindSlot(MessageTemplate tmpl, const char[] name);
+static cell_t MessageTemplateFindSlot(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_template = 1,
+        arg_name
+    };
+
+    SPMod::IMessageTemplate *msgTemplate = gMessageTemplates.get(params[arg_template]);
+
+    if (!msgTemplate)
+    {
+        ctx->ReportError("Invalid message template id (%d).", params[arg_template]);
+        return -1;
+    }
+
+    char *name;
+    ctx->LocalToString(params[arg_name], &name);
+
+    std::size_t slot = msgTemplate->getSlot(name);
+
+    return (slot == SPMod::IMessageTemplate::INVALID_SLOT) ? -1 : static_cast<cell_t>(slot);
+}
+
+// native void MessageTemplateSetString(MessageTemplate tmpl, int slot, const char[] value);
+static cell_t MessageTemplateSetString(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_template = 1,
+        arg_slot,
+        arg_value
+    };
+
+    SPMod::IMessageTemplate *msgTemplate = gMessageTemplates.get(params[arg_template]);
+
+    if (!msgTemplate)
+    {
+        ctx->ReportError("Invalid message template id (%d).", params[arg_template]);
+        return 0;
+    }
+
+    if (params[arg_slot] < 0 || static_cast<std::size_t>(params[arg_slot]) >= msgTemplate->getSlots() ||
+        msgTemplate->getSlotType(params[arg_slot]) != SPMod::MsgParamType::String)
+    {
+        ctx->ReportError("Invalid string slot (%d).", params[arg_slot]);
+        return 0;
+    }
+
+    char *value;
+    ctx->LocalToString(params[arg_value], &value);
+
+    gTemplateStrings[msgTemplate][params[arg_slot]] = value;
+
+    return 1;
+}
+
+// native bool SendMessageTemplate(MessageTemplate tmpl,
+//                                 MessageDest dest,
+//                                 int target,
+//                                 const any[] values,
+//                                 int count,
+//                                 const float origin[3] = {0.0, 0.0, 0.0},
+//                                 CallType type = Not_Hookable);
+static cell_t SendMessageTemplate(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_template = 1,
+        arg_dest,
+        arg_target,
+        arg_values,
+        arg_count,
+        arg_origin,
+        arg_type
+    };
+
+    // Kept between calls, so sending does not allocate
+    static std::vector<SPMod::MsgSlotValue> values;
+
+    SPMod::IMessageTemplate *msgTemplate = gMessageTemplates.get(params[arg_template]);
+
+    if (!msgTemplate)
+    {
+        ctx->ReportError("Invalid message template id (%d).", params[arg_template]);
+        return 0;
+    }
+
+    std::size_t slots = msgTemplate->getSlots();
+
+    if (params[arg_count] < 0 || static_cast<std::size_t>(params[arg_count]) != slots)
+    {
+        ctx->ReportError("Template has %u slots, %d values given.", static_cast<unsigned int>(slots),
+                         params[arg_count]);
+        return 0;
+    }
+
+    auto dest = static_cast<SPMod::MsgDest>(params[arg_dest]);
+    SPMod::Engine::IEdict *target = nullptr;
+
+    if (dest == SPMod::MsgDest::ONE || dest == SPMod::MsgDest::ONE_UNRELIABLE)
+    {
+        SPMod::IPlayer *player = gSPGlobal->getPlayerManager()->getPlayer(params[arg_target]);
+
+        if (!player || !player->isInGame())
+        {
+            ctx->ReportError("Player %d is not in game.", params[arg_target]);
+            return 0;
+        }
+
+        target = player->edict();
+    }
+
+    cell_t *cpValues;
+    cell_t *cpOrigin;
+    ctx->LocalToPhysAddr(params[arg_values], &cpValues);
+    ctx->LocalToPhysAddr(params[arg_origin], &cpOrigin);
+
+    const std::vector<std::string> &strings = gTemplateStrings[msgTemplate];
+
+    values.clear();
+    for (std::size_t i = 0; i < slots; i++)
+    {
+        switch (msgTemplate->getSlotType(i))
+        {
+            case SPMod::MsgParamType::String:
+                values.emplace_back(std::string_view(strings[i]));
+                break;
+            case SPMod::MsgParamType::Angle:
+            case SPMod::MsgParamType::Coord:
+                values.emplace_back(sp_ctof(cpValues[i]));
+                break;
+            default:
+                values.emplace_back(static_cast<int>(cpValues[i]));
+                break;
+        }
+    }
+
+    float origin[3] = {sp_ctof(cpOrigin[0]), sp_ctof(cpOrigin[1]), sp_ctof(cpOrigin[2])};
+
+    return gSPMsgMngr->sendTemplate(msgTemplate, dest, origin, target, values.data(), values.size(),
+                                    params[arg_type] == 1);
+}
+
 // native void MessageBegin(int dest, int msgid, const int origin[3] = {0,0,0}, int player = 0);
 static cell_t MessageBegin(SourcePawn::IPluginContext *ctx, const cell_t *params)
 {
@@ -570,7 +1015,20 @@ sp_nativeinfo_t gMessageNatives[] = {{"GetUserMsgId", GetUserMsgId},
                                      {"GetUserMsgName", GetUserMsgName},
 
                                      {"HookMessage", HookMessage},
+                                     {"ObserveMessage", ObserveMessage},
                                      {"UnhookMessage", UnhookMessage},
+                                     {"AddMsgHookCondition", AddMsgHookCondition},
+                                     {"AddMsgHookStringCondition", AddMsgHookStringCondition},
+                                     {"ClearMsgHookConditions", ClearMsgHookConditions},
+
+                                     {"CreateMessageTemplate", CreateMessageTemplate},
+                                     {"DestroyMessageTemplate", DestroyMessageTemplate},
+                                     {"MessageTemplateAddArg", MessageTemplateAddArg},
+                                     {"MessageTemplateAddString", MessageTemplateAddString},
+                                     {"MessageTemplateAddSlot", MessageTemplateAddSlot},
+                                     {"MessageTemplateFindSlot", MessageTemplateFindSlot},
+                                     {"MessageTemplateSetString", MessageTemplateSetString},
+                                     {"SendMessageTemplate", SendMessageTemplate},
 
                                      {"GetMsgBlock", GetMsgBlock},
                                      {"SetMsgBlock", SetMsgBlock},
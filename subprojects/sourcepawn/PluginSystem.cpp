@@ -188,6 +188,7 @@ namespace SPExt
 
         m_exportedPlugins.emplace_back(plugin.get());
         m_plugins.emplace(fileName, std::move(plugin));
+        clearForwardsCache();
 
         return m_plugins.at(fileName).get();
     }
@@ -255,6 +256,16 @@ namespace SPExt
 
     void PluginMngr::unloadPlugins()
     {
+        // Timers of unloaded plugins must not fire anymore
+        for (const auto &entry : m_plugins)
+            gSPTimerMngr->cancelOwnerTimers(entry.second.get());
+
+        gTimerHandlers.clear();
+
+        // Message manager destroys templates right after plugins are unloaded
+        clearMessageTemplates();
+
+        clearForwardsCache();
         m_plugins.clear();
     }
 
@@ -263,6 +274,49 @@ namespace SPExt
         return PluginMngr::pluginsExtension;
     }
 
+    const PluginMngr::ForwardSubscribers &PluginMngr::getForwardSubscribers(const SPMod::IForward *fwd)
+    {
+        SPMod::IPlugin *fwdPlugin = fwd->getPlugin();
+        auto [iter, inserted] = m_forwardsCache.try_emplace(fwd);
+        ForwardSubscribers &subscribers = iter->second;
+
+        // Forward could have been deleted and another one allocated at the same address
+        if (!inserted && subscribers.plugin == fwdPlugin && subscribers.name == fwd->getName())
+            return subscribers;
+
+        subscribers.name = fwd->getName();
+        subscribers.plugin = fwdPlugin;
+        subscribers.functions.clear();
+        subscribers.plugins.clear();
+
+        auto addSubscriber = [&subscribers](Plugin *plugin) {
+            SourcePawn::IPluginFunction *func = plugin->getRuntime()->GetFunctionByName(subscribers.name.c_str());
+            if (func)
+            {
+                subscribers.functions.emplace_back(func);
+                subscribers.plugins.emplace_back(plugin);
+            }
+        };
+
+        if (fwdPlugin)
+        {
+            if (Plugin *plugin = getPlugin(fwdPlugin); plugin)
+                addSubscriber(plugin);
+        }
+        else
+        {
+            for (const auto &entry : m_plugins)
+                addSubscriber(entry.second.get());
+        }
+
+        return subscribers;
+    }
+
+    void PluginMngr::clearForwardsCache()
+    {
+        m_forwardsCache.clear();
+    }
+
     SPVM_NATIVE_FUNC PluginMngr::findNative(std::string_view name)
     {
         if (auto iter = m_natives.find(name.data()); iter != m_natives.end())
@@ -68,6 +68,15 @@ namespace SPExt
     public:
         constexpr static const char *pluginsExtension = ".smx";
 
+        /* Functions implementing a forward, resolved once per plugins (un)load */
+        struct ForwardSubscribers
+        {
+            std::string name;
+            SPMod::IPlugin *plugin;
+            std::vector<SourcePawn::IPluginFunction *> functions;
+            std::vector<SPMod::IPlugin *> plugins; /* Plugin of function with the same index */
+        };
+
         PluginMngr() = default;
         ~PluginMngr() = default;
 
@@ -92,6 +101,10 @@ namespace SPExt
         Plugin *getPlugin(SourcePawn::IPluginContext *ctx) const;
         Plugin *getPlugin(SPMod::IPlugin *plugin) const;
 
+        // Forwards
+        const ForwardSubscribers &getForwardSubscribers(const SPMod::IForward *fwd);
+        void clearForwardsCache();
+
         void clearNatives();
         void addDefaultNatives();
         SPVM_NATIVE_FUNC findNative(std::string_view name);
@@ -110,5 +123,6 @@ namespace SPExt
         std::vector<SPMod::IPlugin *> m_exportedPlugins;
         std::unordered_map<std::string, SPVM_NATIVE_FUNC> m_natives;
         std::unordered_map<std::string, NativeCallback *> m_pluginNatives;
+        std::unordered_map<const SPMod::IForward *, ForwardSubscribers> m_forwardsCache;
     };
 } // namespace SPExt
@@ -20,6 +20,9 @@
 #include "ExtMain.hpp"
 
 TypeHandler<SPMod::ITimer> gTimerHandlers;
+
+// native Timer(float interval, TimerCallback func, any data = 0, bool exec = false, bool pause = false,
+//              int group = 0);
 static cell_t TimerCtor(SourcePawn::IPluginContext *ctx, const cell_t *params)
 {
     enum
@@ -28,15 +31,17 @@ static cell_t TimerCtor(SourcePawn::IPluginContext *ctx, const cell_t *params)
         arg_func,
         arg_data,
         arg_exec,
-        arg_pause
+        arg_pause,
+        arg_group
     };
 
     SourcePawn::IPluginFunction *func = ctx->GetFunctionById(params[arg_func]);
+    auto group = static_cast<std::uint32_t>(params[0] >= arg_group ? params[arg_group] : 0);
     SPMod::ITimer *timer;
 
     try
     {
-        timer = gSPTimerMngr->createTimer(
+        timer = gSPTimerMngr->createOwnedTimer(
             sp_ctof(params[arg_interval]),
             [func, params] (SPMod::ITimer *const timer) {
                 if (func && func->IsRunnable())
@@ -45,10 +50,16 @@ static cell_t TimerCtor(SourcePawn::IPluginContext *ctx, const cell_t *params)
                     func->PushCell(gTimerHandlers.getKey(timer));
                     func->PushCell(params[arg_data]);
                     func->Execute(&result);
-                    return static_cast<SPMod::IForward::ReturnValue>(result) != SPMod::IForward::ReturnValue::Stop;
+
+                    if (static_cast<SPMod::IForward::ReturnValue>(result) == SPMod::IForward::ReturnValue::Stop)
+                    {
+                        // Timer is going to be removed
+                        gTimerHandlers.free(gTimerHandlers.getKey(timer));
+                        return false;
+                    }
                 }
                 return true;
-            }, params[arg_pause]);
+            }, params[arg_pause], gAdapterInterface->getPluginMngr()->getPlugin(ctx), group);
     }
     catch (const std::runtime_error &e)
     {
@@ -56,13 +67,27 @@ static cell_t TimerCtor(SourcePawn::IPluginContext *ctx, const cell_t *params)
         return -1;
     }
 
+    if (!timer)
+    {
+        ctx->ReportError("Invalid timer interval (%f)", sp_ctof(params[arg_interval]));
+        return -1;
+    }
+
     if (params[arg_exec] && !timer->exec())
     {
         gSPTimerMngr->removeTimer(timer);
         return -1;
     }
 
-    return gTimerHandlers.create(timer);
+    std::size_t id = gTimerHandlers.create(timer);
+    if (id == TypeHandler<SPMod::ITimer>::INVALID_HANDLE)
+    {
+        gSPTimerMngr->removeTimer(timer);
+        ctx->ReportError("Too many timers");
+        return -1;
+    }
+
+    return id;
 }
 
 static cell_t PauseGet(SourcePawn::IPluginContext *ctx, const cell_t *params)
@@ -178,6 +203,50 @@ static cell_t Remove(SourcePawn::IPluginContext *ctx [[maybe_unused]], const cel
     return 1;
 }
 
+// native void Timer.PauseGroup(int group);
+static cell_t PauseGroup(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_group = 1
+    };
+
+    gSPTimerMngr->pauseGroup(gAdapterInterface->getPluginMngr()->getPlugin(ctx),
+                             static_cast<std::uint32_t>(params[arg_group]));
+    return 1;
+}
+
+// native void Timer.ResumeGroup(int group);
+static cell_t ResumeGroup(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_group = 1
+    };
+
+    gSPTimerMngr->resumeGroup(gAdapterInterface->getPluginMngr()->getPlugin(ctx),
+                              static_cast<std::uint32_t>(params[arg_group]));
+    return 1;
+}
+
+// native void Timer.RemoveGroup(int group);
+static cell_t RemoveGroup(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_group = 1
+    };
+
+    SPMod::IPlugin *owner = gAdapterInterface->getPluginMngr()->getPlugin(ctx);
+    auto group = static_cast<std::uint32_t>(params[arg_group]);
+
+    for (SPMod::ITimer *timer : gSPTimerMngr->getGroupTimers(owner, group))
+        gTimerHandlers.free(gTimerHandlers.getKey(timer));
+
+    gSPTimerMngr->cancelGroup(owner, group);
+    return 1;
+}
+
 sp_nativeinfo_t gTimerNatives[] = {{"Timer.Timer", TimerCtor},
                                    {"Timer.Paused.get", PauseGet},
                                    {"Timer.Interval.get", IntervalGet},
@@ -185,4 +254,7 @@ sp_nativeinfo_t gTimerNatives[] = {{"Timer.Timer", TimerCtor},
                                    {"Timer.Interval.set", IntervalSet},
                                    {"Timer.Trigger", Trigger},
                                    {"Timer.Remove", Remove},
+                                   {"Timer.PauseGroup", PauseGroup},
+                                   {"Timer.ResumeGroup", ResumeGroup},
+                                   {"Timer.RemoveGroup", RemoveGroup},
                                    {nullptr, nullptr}};
\ No newline at end of file
@@ -19,72 +19,123 @@
 
 #pragma once
 
-#include <queue>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 
+/*
+ * Maps objects to handles passed to plugins.
+ *
+ * Handle consists of slot index and generation of the slot. Generation changes when the slot is freed,
+ * so handles of freed objects are not valid anymore even if the slot gets reused. Slot which used up
+ * its generations is retired instead, so a handle is never given out twice.
+ */
 template<typename T>
 class TypeHandler
 {
 public:
+    static constexpr std::size_t INVALID_HANDLE = static_cast<std::size_t>(-1);
+
+    /* Handles have to fit in a positive cell */
+    static constexpr std::size_t INDEX_BITS = 20;
+    static constexpr std::size_t GENERATION_BITS = 11;
+    static constexpr std::size_t INDEX_MASK = (1U << INDEX_BITS) - 1;
+    static constexpr std::size_t GENERATION_MASK = (1U << GENERATION_BITS) - 1;
+
+    /* Object which already has a handle gets the same one, INVALID_HANDLE if there are no slots left */
     std::size_t create(T *data)
     {
-        std::size_t id = 0;
-        if (!m_freeIds.empty())
+        if (auto iter = m_keys.find(data); iter != m_keys.end())
+            return iter->second;
+
+        std::size_t index;
+        if (!m_freeSlots.empty())
         {
-            id = m_freeIds.front();
-            m_freeIds.pop();
+            index = m_freeSlots.back();
+            m_freeSlots.pop_back();
         }
         else
         {
-            id = m_handlers.size();
+            index = m_slots.size();
+            if (index > INDEX_MASK)
+                return INVALID_HANDLE;
+
+            m_slots.emplace_back();
         }
 
-        m_handlers[id] = data;
-        return id;
+        Slot &slot = m_slots[index];
+        slot.data = data;
+
+        std::size_t handle = slot.generation << INDEX_BITS | index;
+        m_keys.emplace(data, handle);
+
+        return handle;
     }
 
-    T *get(std::size_t id)
+    T *get(std::size_t handle) const
     {
-        try
-        {
-            return m_handlers.at(id);
-        }
-        catch (const std::out_of_range &e)
-        {
-            (void)e;
+        std::size_t index = handle & INDEX_MASK;
+        if (index >= m_slots.size())
             return nullptr;
-        }
+
+        const Slot &slot = m_slots[index];
+        if (slot.generation != handle >> INDEX_BITS)
+            return nullptr;
+
+        return slot.data;
     }
 
-    std::size_t getKey(T *data)
+    std::size_t getKey(const T *data) const
     {
-        for (const auto &[key, content] : m_handlers)
-        {
-            if (content == data)
-                return key;
-        }
-
-        return static_cast<std::size_t>(-1);
+        auto iter = m_keys.find(data);
+        return iter != m_keys.end() ? iter->second : INVALID_HANDLE;
     }
 
-    void free(std::size_t id)
+    void free(std::size_t handle)
     {
-        if (m_handlers.find(id) == m_handlers.end() || !m_handlers[id])
+        T *data = get(handle);
+        if (!data)
             return;
 
-        m_handlers[id] = nullptr;
-        m_freeIds.push(id);
+        m_keys.erase(data);
+        _release(handle & INDEX_MASK);
     }
 
+    /* Slots are kept, so handles from before stay invalid */
     void clear()
     {
-        m_handlers.clear();
-        while (!m_freeIds.empty())
+        for (std::size_t index = m_slots.size(); index-- > 0;)
         {
-            m_freeIds.pop();
+            if (m_slots[index].data)
+                _release(index);
         }
+
+        m_keys.clear();
     }
 
 private:
-    std::unordered_map<std::size_t, T *> m_handlers;
-    std::queue<std::size_t> m_freeIds;
+    struct Slot
+    {
+        T *data = nullptr;
+        std::size_t generation = 0;
+    };
+
+    /* Invalidates handles of the slot, retires it once its generation would wrap */
+    void _release(std::size_t index)
+    {
+        Slot &slot = m_slots[index];
+        slot.data = nullptr;
+
+        if (slot.generation == GENERATION_MASK)
+            return;
+
+        slot.generation++;
+        m_freeSlots.push_back(index);
+    }
+
+    std::vector<Slot> m_slots;
+    std::vector<std::size_t> m_freeSlots;
+
+    /* Reverse lookup, object to its handle */
+    std::unordered_map<const T *, std::size_t> m_keys;
 };
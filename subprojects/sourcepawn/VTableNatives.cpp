@@ -19,10 +19,12 @@
 
 #include "ExtMain.hpp"
 
-std::unordered_multimap<SPMod::IVTableHook *, SourcePawn::IPluginFunction *> gVTableHook;
-std::unordered_multimap<SPMod::IVTableHook *, SourcePawn::IPluginFunction *> gVTableHookPost;
+std::unordered_multimap<SPMod::IVTableHook *, VTableHookCallback> gVTableHook;
+std::unordered_multimap<SPMod::IVTableHook *, VTableHookCallback> gVTableHookPost;
 TypeHandler<SPMod::IVTableHook> gVTableHandlers;
 
+// native VTHook(VTableFunc vfunc, const char[] classname, VTHookCallback callback, bool post,
+//                bool playersOnly = false);
 static cell_t VTableHookRegister(SourcePawn::IPluginContext *ctx, const cell_t *params)
 {
     enum
@@ -30,28 +32,87 @@ static cell_t VTableHookRegister(SourcePawn::IPluginContext *ctx, const cell_t *
         arg_vfunc = 1,
         arg_classname,
         arg_callback,
-        arg_post
+        arg_post,
+        arg_players_only
     };
 
     auto vFunc = static_cast<SPMod::IVTableHookManager::vFuncType>(params[arg_vfunc]);
 
     char *className;
     ctx->LocalToString(params[arg_classname], &className);
+
+    SPMod::VTableHookFilter filter;
+    filter.playersOnly = params[0] >= arg_players_only && params[arg_players_only];
+
     SPMod::IVTableHookManager *vTableMngr = gSPGlobal->getVTableManager();
-    SPMod::IVTableHook *hook = vTableMngr->registerHook(vFunc, className);
+    SPMod::IVTableHook *hook = vTableMngr->registerHook(vFunc, className, filter.playersOnly ? &filter : nullptr);
     if (!hook)
         return -1;
 
+    std::size_t id = gVTableHandlers.create(hook);
+    if (id == TypeHandler<SPMod::IVTableHook>::INVALID_HANDLE)
+    {
+        ctx->ReportError("Too many vtable hooks");
+        return -1;
+    }
+
+    VTableHookCallback callback {ctx->GetFunctionById(params[arg_callback]), filter.playersOnly};
+    if (!params[arg_post])
+    {
+        gVTableHook.emplace(hook, callback);
+    }
+    else
+    {
+        gVTableHookPost.emplace(hook, callback);
+    }
+
+    return id;
+}
+
+// native VTHook VTHook.FromName(const char[] function, const char[] classname, VTHookCallback callback, bool post,
+//                               bool playersOnly = false);
+static cell_t VTableHookRegisterByName(SourcePawn::IPluginContext *ctx, const cell_t *params)
+{
+    enum
+    {
+        arg_function = 1,
+        arg_classname,
+        arg_callback,
+        arg_post,
+        arg_players_only
+    };
+
+    char *function;
+    char *className;
+    ctx->LocalToString(params[arg_function], &function);
+    ctx->LocalToString(params[arg_classname], &className);
+
+    SPMod::VTableHookFilter filter;
+    filter.playersOnly = params[0] >= arg_players_only && params[arg_players_only];
+
+    SPMod::IVTableHook *hook = gSPGlobal->getVTableManager()->registerHook(std::string_view(function), className,
+                                                                           filter.playersOnly ? &filter : nullptr);
+    if (!hook)
+        return -1;
+
+    std::size_t id = gVTableHandlers.create(hook);
+    if (id == TypeHandler<SPMod::IVTableHook>::INVALID_HANDLE)
+    {
+        ctx->ReportError("Too many vtable hooks");
+        return -1;
+    }
+
+    VTableHookCallback callback {ctx->GetFunctionById(params[arg_callback]), filter.playersOnly};
     if (!params[arg_post])
     {
-        gVTableHook.emplace(hook, ctx->GetFunctionById(params[arg_callback]));
+        gVTableHook.emplace(hook, callback);
     }
     else
     {
-        gVTableHookPost.emplace(hook, ctx->GetFunctionById(params[arg_callback]));
+        gVTableHookPost.emplace(hook, callback);
     }
 
-    return gVTableHandlers.create(hook);
+    return id;
 }
 
 static cell_t VTableHookSetFloat(SourcePawn::IPluginContext *ctx [[maybe_unused]], const cell_t *params)
@@ -87,5 +148,6 @@ static cell_t VTableHookSetFloat(SourcePawn::IPluginContext *ctx [[maybe_unused]
 }
 
 sp_nativeinfo_t gVTableNatives[] = {{"VTHook.VTHook", VTableHookRegister},
+                                    {"VTHook.FromName", VTableHookRegisterByName},
                                     {"VTHook.SetFloat", VTableHookSetFloat},
                                     {nullptr, nullptr}};
\ No newline at end of file